@@ -4,6 +4,8 @@ module;
 module GIScript;
 
 import script;
+import trace;
+import memory_usage;
 
 using namespace Ugc::Script;
 
@@ -19,6 +21,394 @@ DeclarationNode::DeclarationNode()
 {
 }
 
+struct UsageInspector : ASTVisitor
+{
+	std::unordered_set<std::string> reads;
+	std::unordered_set<std::string> writes;
+	bool pure = true;
+
+	std::any VisitIdentifier(const std::string& id) override
+	{
+		reads.insert(id);
+		return id;
+	}
+
+	std::any VisitAssignment(const std::any& ref, Assignment::Op op, const std::any& value, bool discard) override
+	{
+		pure = false;
+		if (ref.type() == typeid(std::string)) writes.insert(std::any_cast<const std::string&>(ref));
+		return {};
+	}
+
+	std::any VisitIncrement(const std::any& ref, bool inv, bool pre, bool discard) override
+	{
+		pure = false;
+		if (ref.type() == typeid(std::string)) writes.insert(std::any_cast<const std::string&>(ref));
+		return {};
+	}
+
+	void VisitVarDef(const std::string& id, VarType type, const std::any& value) override
+	{
+		writes.insert(id);
+	}
+
+	std::any VisitCall(const std::any& value, const std::vector<std::any>& args, std::optional<VarType> type) override
+	{
+		pure = false;
+		return {};
+	}
+
+	std::any VisitMemberAccess(const std::any& value, const std::any& member, std::optional<VarType> type) override
+	{
+		pure = false;
+		return value;
+	}
+
+	std::any VisitConstruct(VarType type, const std::vector<std::any>& args) override
+	{
+		pure = false;
+		return {};
+	}
+
+	std::any VisitInitializerList(const std::vector<std::any>& values) override
+	{
+		pure = false;
+		return {};
+	}
+};
+
+struct InlineInspector : UsageInspector
+{
+	std::size_t cost = 0;
+	std::unordered_set<std::string> calls;
+
+	std::any VisitCall(const std::any& value, const std::vector<std::any>& args, std::optional<VarType> type) override
+	{
+		++cost;
+		if (value.type() == typeid(std::string)) calls.insert(std::any_cast<const std::string&>(value));
+		return UsageInspector::VisitCall(value, args, type);
+	}
+
+	std::any VisitAssignment(const std::any& ref, Assignment::Op op, const std::any& value, bool discard) override
+	{
+		++cost;
+		return UsageInspector::VisitAssignment(ref, op, value, discard);
+	}
+
+	std::any VisitIncrement(const std::any& ref, bool inv, bool pre, bool discard) override
+	{
+		++cost;
+		return UsageInspector::VisitIncrement(ref, inv, pre, discard);
+	}
+
+	std::any VisitMemberAccess(const std::any& value, const std::any& member, std::optional<VarType> type) override
+	{
+		++cost;
+		return UsageInspector::VisitMemberAccess(value, member, type);
+	}
+
+	std::any VisitUnary(UnaryExpr::Op op, const std::any& value) override
+	{
+		++cost;
+		return {};
+	}
+
+	std::any VisitBinary(BinaryExpr::Op op, const std::any& l, const std::any& r) override
+	{
+		++cost;
+		return {};
+	}
+
+	std::any VisitTernary(const std::any& e1, const std::any& e2, const std::any& e3) override
+	{
+		++cost;
+		return {};
+	}
+
+	std::any VisitCast(VarType type, const std::any& value) override
+	{
+		++cost;
+		return {};
+	}
+};
+
+static std::string TypeKey(const VarType& type)
+{
+	switch (type.type)
+	{
+	case VarType::Guid: return std::format("G{}", (int)std::any_cast<GuidEx>(type.extra));
+	case VarType::List: return std::format("[{}]", TypeKey(std::any_cast<const VarType&>(type.extra)));
+	case VarType::Map:
+	{
+		auto& [key, value] = std::any_cast<const MapEx&>(type.extra);
+		return std::format("{{{}:{}}}", TypeKey(key), TypeKey(value));
+	}
+	case VarType::Tuple:
+	{
+		std::string key = "(";
+		for (auto& t : std::any_cast<const std::vector<VarType>&>(type.extra)) key += TypeKey(t) + ",";
+		return key + ")";
+	}
+	default: return std::to_string((int)type.type);
+	}
+}
+
+// records the exact sequence of visitor calls a statement run produces, with locals numbered by declaration
+// and free identifiers by first use, so two runs with equal logs lower to the same nodes
+struct Fingerprint : ASTVisitor
+{
+	struct Entry
+	{
+		std::string text;
+		std::string free;
+	};
+
+	std::vector<Entry> log;
+	std::vector<std::size_t> origins;
+	std::vector<std::string> roots;
+	std::unordered_set<std::string> seen, declared, written, callees;
+	std::size_t locals = 0, loops = 0, cost = 0;
+	bool returns = false;
+	bool poisoned = false;
+
+	std::any Value(std::string text, std::string root = {}, std::string free = {})
+	{
+		origins.push_back(log.size());
+		log.emplace_back(std::move(text), std::move(free));
+		roots.push_back(std::move(root));
+		return roots.size() - 1;
+	}
+
+	static std::string Ref(const std::any& value)
+	{
+		return value.has_value() ? std::format("#{}", std::any_cast<std::size_t>(value)) : "_";
+	}
+
+	static std::string Refs(const std::vector<std::any>& values)
+	{
+		std::string text;
+		for (auto& v : values) text += Ref(v) + ",";
+		return text;
+	}
+
+	static std::string Type(const std::optional<VarType>& type)
+	{
+		return type ? TypeKey(*type) : "?";
+	}
+
+	void Statement(std::string text)
+	{
+		log.emplace_back(std::move(text));
+		++cost;
+	}
+
+	void Declare(const std::string& id, const VarType& type)
+	{
+		if (scope.contains(id) || seen.contains(id)) poisoned = true;
+		scope.add(id, std::make_unique<LocalVar>(type, std::format("%{}", locals++)));
+		declared.insert(id);
+	}
+
+	void Write(const std::any& ref)
+	{
+		if (!ref.has_value()) return;
+		auto value = std::any_cast<std::size_t>(ref);
+		if (!log[origins[value]].free.empty()) poisoned = true;
+		else if (!roots[value].empty()) written.insert(roots[value]);
+	}
+
+	std::string Render() const
+	{
+		std::unordered_map<std::string, std::size_t> index;
+		std::string text;
+		for (auto& [t, free] : log)
+		{
+			if (free.empty()) text += t;
+			else text += std::format("${}", index.try_emplace(free, index.size()).first->second);
+			text += '\n';
+		}
+		return text;
+	}
+
+	std::vector<std::string> Arguments() const
+	{
+		std::vector<std::string> arguments;
+		for (auto& e : log) if (!e.free.empty() && std::ranges::find(arguments, e.free) == arguments.end()) arguments.push_back(e.free);
+		return arguments;
+	}
+
+	void VisitVarDef(const std::string& id, VarType type, const std::any& value) override
+	{
+		Statement(std::format("var {} {}", TypeKey(type), Ref(value)));
+		Declare(id, type);
+	}
+
+	void VisitExprStatement(const std::any& value) override { Statement("expr " + Ref(value)); }
+	void VisitIfStatement(IfStatement::Phase phase, std::any& value) override { Statement(std::format("if{} {}", (int)phase, Ref(value))); }
+	void VisitSwitchStatement(int count, std::any& value, bool end) override { Statement(std::format("switch{} {} {}", (int)end, count, Ref(value))); }
+	void VisitCase(const std::any& literal, std::any& value) override { Statement(std::format("case {} {}", Ref(literal), Ref(value))); }
+
+	void VisitWhile(std::any& value, bool end) override
+	{
+		Statement(std::format("while{} {}", (int)end, Ref(value)));
+		if (end) --loops;
+		else ++loops;
+	}
+
+	void VisitFor(std::any& value, bool end) override
+	{
+		Statement(std::format("for{} {}", (int)end, Ref(value)));
+		if (end) --loops;
+		else ++loops;
+	}
+
+	void VisitCountedForStart(const std::string& var, const std::any& begin, const std::any& end, bool inclusive, std::any& value) override
+	{
+		Statement(std::format("count {} {} {}", Ref(begin), Ref(end), (int)inclusive));
+		Declare(var, { VarType::Int });
+		++loops;
+	}
+
+	void VisitCountedForEnd(std::any& value) override
+	{
+		Statement("count_end");
+		--loops;
+	}
+
+	void VisitForEachStart(VarType type, const std::string& var, std::any& value) override
+	{
+		Statement(std::format("foreach {} {}", TypeKey(type), Ref(value)));
+		Declare(var, type);
+		++loops;
+	}
+
+	void VisitForEachEnd(std::any& value) override
+	{
+		Statement("foreach_end");
+		--loops;
+	}
+
+	void VisitBreak() override
+	{
+		if (!loops) poisoned = true;
+		Statement("break");
+	}
+
+	void VisitReturn(const std::any& value) override
+	{
+		if (!returns) poisoned = true;
+		Statement("return " + Ref(value));
+	}
+
+	std::any VisitLiteral(Literal::Type type, const std::any& value) override
+	{
+		switch (type)
+		{
+		case Literal::Int: return Value(std::format("int {}", std::any_cast<int64_t>(value)));
+		case Literal::Float: return Value(std::format("float {}", std::any_cast<float>(value)));
+		case Literal::Bool: return Value(std::format("bool {}", std::any_cast<bool>(value)));
+		case Literal::String:
+		{
+			auto& str = std::any_cast<const std::string&>(value);
+			return Value(std::format("str {} {}", str.size(), str));
+		}
+		default: return Value(std::format("lit {}", (int)type));
+		}
+	}
+
+	std::any VisitIdentifier(const std::string& id) override
+	{
+		if (auto local = scope.find(id)) return Value(std::any_cast<const std::string&>(local->content));
+		seen.insert(id);
+		return Value({}, id, id);
+	}
+
+	std::any VisitAssignment(const std::any& ref, Assignment::Op op, const std::any& value, bool discard) override
+	{
+		Write(ref);
+		++cost;
+		return Value(std::format("assign {} {} {} {}", (int)op, Ref(ref), Ref(value), (int)discard));
+	}
+
+	std::any VisitIncrement(const std::any& ref, bool inv, bool pre, bool discard) override
+	{
+		Write(ref);
+		++cost;
+		return Value(std::format("inc {} {} {} {}", Ref(ref), (int)inv, (int)pre, (int)discard));
+	}
+
+	std::any VisitCall(const std::any& value, const std::vector<std::any>& args, std::optional<VarType> type) override
+	{
+		if (value.has_value())
+		{
+			auto callee = std::any_cast<std::size_t>(value);
+			if (auto& e = log[origins[callee]]; !e.free.empty())
+			{
+				callees.insert(e.free);
+				e.text = "@" + e.free;
+				e.free.clear();
+				roots[callee].clear();
+			}
+		}
+		++cost;
+		return Value(std::format("call {} ({}) {}", Ref(value), Refs(args), Type(type)));
+	}
+
+	std::any VisitMemberAccess(const std::any& value, const std::any& member, std::optional<VarType> type) override
+	{
+		++cost;
+		return Value(std::format("member {} {} {}", Ref(value), Ref(member), Type(type)), value.has_value() ? roots[std::any_cast<std::size_t>(value)] : std::string{});
+	}
+
+	bool VisitInvolution(UnaryExpr::Op op, const std::any& value) override
+	{
+		Value(std::format("involution {} {}", (int)op, Ref(value)));
+		return false;
+	}
+
+	std::any VisitUnary(UnaryExpr::Op op, const std::any& value) override
+	{
+		++cost;
+		return Value(std::format("unary {} {}", (int)op, Ref(value)));
+	}
+
+	std::any VisitBinary(BinaryExpr::Op op, const std::any& l, const std::any& r) override
+	{
+		++cost;
+		return Value(std::format("binary {} {} {}", (int)op, Ref(l), Ref(r)));
+	}
+
+	std::any VisitTernary(const std::any& e1, const std::any& e2, const std::any& e3) override
+	{
+		++cost;
+		return Value(std::format("ternary {} {} {}", Ref(e1), Ref(e2), Ref(e3)));
+	}
+
+	std::any VisitCast(VarType type, const std::any& value) override
+	{
+		++cost;
+		return Value(std::format("cast {} {}", TypeKey(type), Ref(value)));
+	}
+
+	std::any VisitConstruct(VarType type, const std::vector<std::any>& args) override
+	{
+		++cost;
+		return Value(std::format("construct {} ({})", TypeKey(type), Refs(args)));
+	}
+
+	std::any VisitInitializerList(const std::vector<std::any>& values) override
+	{
+		++cost;
+		return Value(std::format("list ({})", Refs(values)));
+	}
+
+	VarType TypeInference(const std::any& value) override
+	{
+		Value("infer " + Ref(value));
+		return {};
+	}
+};
+
 RootNode::RootNode(std::vector<std::unique_ptr<DeclarationNode>> declarations, std::vector<std::unique_ptr<FunctionNode>> global_functions) : declarations(std::move(declarations)), global_functions(std::move(global_functions))
 {
 }
@@ -59,7 +449,7 @@ EventNode::EventNode(const std::string& event, std::vector<Variable> parameters,
 	this->body.Visit(checker);
 }
 
-FunctionNode::FunctionNode(const std::string& name, std::optional<VarType> ret, std::vector<Variable> parameters, BlockNode body) : name(name), parameters(std::move(parameters)), ret(std::move(ret)), body(std::move(body))
+FunctionNode::FunctionNode(const std::string& name, std::optional<VarType> ret, std::vector<Variable> parameters, BlockNode body, Hint hint) : name(name), parameters(std::move(parameters)), ret(std::move(ret)), body(std::move(body)), hint(hint)
 {
 	struct Checker : ASTVisitor
 	{
@@ -76,6 +466,26 @@ FunctionNode::FunctionNode(const std::string& name, std::optional<VarType> ret,
 		}
 		else s->Visit(checker);
 	}
+	UsageInspector usage;
+	this->body.Visit(usage);
+	writes = std::move(usage.writes);
+	if (auto r = this->body.statements.empty() ? nullptr : dynamic_cast<Return*>(this->body.statements.back().get()); r && r->expr)
+	{
+		UsageInspector value;
+		r->expr->Eval(value);
+		tail_return = value.pure;
+	}
+	if (this->body.statements.size() != 1) return;
+	ExpressionNode* expr = nullptr;
+	if (auto r = dynamic_cast<Return*>(this->body.statements.front().get())) expr = r->expr.get();
+	else if (auto e = dynamic_cast<ExprStatement*>(this->body.statements.front().get()); e && !this->ret) expr = e->expr.get();
+	if (!expr) return;
+	InlineInspector inspector;
+	expr->Eval(inspector);
+	if (inspector.calls.contains(name)) return;
+	cost = inspector.cost;
+	pure = inspector.pure;
+	calls = std::move(inspector.calls);
 }
 
 Return::Return(std::unique_ptr<ExpressionNode> expr) : expr(std::move(expr))
@@ -86,6 +496,14 @@ VarDef::VarDef(std::vector<Variable> vars) : vars(std::move(vars))
 {
 }
 
+GraphVarDef::GraphVarDef(VarDef def) : vars(std::move(def.vars))
+{
+	for (auto& v : vars)
+	{
+		if (v.Value()) throw std::runtime_error(std::format("Graph variable '{}' cannot have an initializer", v.Id()));
+	}
+}
+
 ExprStatement::ExprStatement(std::unique_ptr<ExpressionNode> expr) : expr(std::move(expr))
 {
 }
@@ -108,6 +526,37 @@ WhileStatement::WhileStatement(std::unique_ptr<ExpressionNode> expr, std::unique
 
 ForStatement::ForStatement(std::unique_ptr<StatementNode> init, std::unique_ptr<ExpressionNode> condition, std::unique_ptr<StatementNode> iteration, std::unique_ptr<StatementNode> body) : init(std::move(init)), condition(std::move(condition)), iteration(std::move(iteration)), body(std::move(body))
 {
+	auto def = dynamic_cast<VarDef*>(this->init.get());
+	auto cond = dynamic_cast<BinaryExpr*>(this->condition.get());
+	auto it = dynamic_cast<ExprStatement*>(this->iteration.get());
+	if (!def || def->Vars().size() != 1 || !cond || !it) return;
+	auto& v = def->Vars().front();
+	if (v.Type().type != VarType::Int || !v.Value()) return;
+	if (cond->Operator() != BinaryExpr::LT && cond->Operator() != BinaryExpr::LE) return;
+	auto is_index = [&](ExpressionNode* e)
+		{
+			auto id = dynamic_cast<Identifier*>(e);
+			return id && id->Id() == v.Id();
+		};
+	if (!is_index(cond->Left())) return;
+	if (auto inc = dynamic_cast<Increment*>(it->Expr()))
+	{
+		if (inc->Decrement() || !is_index(inc->Target())) return;
+	}
+	else if (auto as = dynamic_cast<Assignment*>(it->Expr()))
+	{
+		auto step = dynamic_cast<Literal*>(as->Value());
+		if (as->Operator() != Assignment::Add || !is_index(as->Target()) || !step || step->LiteralType() != Literal::Int || std::any_cast<int64_t>(step->Value()) != 1) return;
+	}
+	else return;
+	UsageInspector bound;
+	InlineInspector usage;
+	cond->Right()->Eval(bound);
+	this->body->Visit(usage);
+	if (!bound.pure || bound.reads.contains(v.Id()) || usage.writes.contains(v.Id())) return;
+	for (auto& id : bound.reads) if (usage.writes.contains(id)) return;
+	counter = Counter{ v.Id(), v.Value(), cond->Right(), cond->Operator() == BinaryExpr::LE };
+	if (!usage.calls.empty()) counter->exposed = std::move(bound.reads);
 }
 
 ForEachStatement::ForEachStatement(VarType type, const std::string& def, std::unique_ptr<ExpressionNode> iterable, std::unique_ptr<StatementNode> body) : type(std::move(type)), def(def), iterable(std::move(iterable)), body(std::move(body))
@@ -202,6 +651,10 @@ InitializerList::InitializerList(std::vector<std::unique_ptr<ExpressionNode>> in
 {
 }
 
+OutlinedStatement::OutlinedStatement(const std::string& name, std::vector<std::unique_ptr<StatementNode>> statements) : name(name), statements(std::move(statements))
+{
+}
+
 class FastFailListener :public antlr4::ANTLRErrorListener
 {
 public:
@@ -234,12 +687,25 @@ std::unique_ptr<ASTNode> Ugc::Script::Parse(const std::string& code)
 	FastFailListener l;
 	lexer.addErrorListener(&l);
 	parser.addErrorListener(&l);
+	GIScriptParser::ProgramContext* program;
+	{
+		Trace::Span span("Parse");
+		Memory::Scope memory("Parse");
+		program = parser.program();
+	}
+	Trace::Span span("BuildAST");
+	Memory::Scope memory("BuildAST");
 	GI::Script::Parser p;
-	p.visitProgram(parser.program());
+	p.visitProgram(program);
 	if (auto t = tokens.LT(1); t->getType() != antlr4::Token::EOF) throw std::runtime_error(std::format("Unexpected token '{}' at line {}:{}.", t->getText(), t->getLine(), t->getCharPositionInLine()));
 	return p.Release();
 }
 
+std::string VarType::Key() const
+{
+	return TypeKey(*this);
+}
+
 bool VarType::operator==(const VarType& other) const
 {
 	if (type != other.type) return false;
@@ -256,7 +722,9 @@ bool VarType::operator==(const VarType& other) const
 
 void RootNode::Visit(ASTVisitor& visitor)
 {
+	visitor.scope.enter();
 	for (auto& c : declarations) c->Visit(visitor);
+	visitor.scope.exit();
 }
 
 void BlockNode::Visit(ASTVisitor& visitor)
@@ -276,12 +744,40 @@ void EventNode::Visit(ASTVisitor& visitor)
 
 void FunctionNode::Visit(ASTVisitor& visitor)
 {
+	if (visitor.VisitInlineFunction(*this)) return;
 	visitor.scope.enter();
 	visitor.VisitFunction(name, ret, parameters);
 	body.Visit(visitor);
 	visitor.scope.exit();
 }
 
+void GraphVarDef::Visit(ASTVisitor& visitor)
+{
+	for (auto& v : vars) visitor.VisitGraphVarDef(v.Id(), v.Type());
+}
+
+std::string FunctionNode::Canonical()
+{
+	Fingerprint fp;
+	fp.returns = true;
+	fp.scope.enter();
+	auto text = std::format("{}(", ret ? TypeKey(*ret) : "void");
+	for (auto& p : parameters)
+	{
+		text += TypeKey(p.Type()) + ",";
+		fp.Declare(p.Id(), p.Type());
+	}
+	body.Visit(fp);
+	return text + ")\n" + fp.Render();
+}
+
+std::any FunctionNode::EvalInline(ASTVisitor& visitor)
+{
+	auto s = body.statements.front().get();
+	if (auto r = dynamic_cast<Return*>(s)) return r->expr->Eval(visitor);
+	return static_cast<ExprStatement*>(s)->expr->Discard(visitor);
+}
+
 void Return::Visit(ASTVisitor& visitor)
 {
 	visitor.VisitReturn(expr ? expr->Eval(visitor) : std::any{});
@@ -289,7 +785,7 @@ void Return::Visit(ASTVisitor& visitor)
 
 void ExprStatement::Visit(ASTVisitor& visitor)
 {
-	visitor.VisitExprStatement(expr->Eval(visitor));
+	visitor.VisitExprStatement(expr->Discard(visitor));
 }
 
 void IfStatement::Visit(ASTVisitor& visitor)
@@ -309,7 +805,7 @@ void IfStatement::Visit(ASTVisitor& visitor)
 
 void CaseNode::Visit(ASTVisitor&)
 {
-	throw std::exception("Invalid call");
+	throw std::runtime_error("Invalid call");
 }
 
 void SwitchStatement::Visit(ASTVisitor& visitor)
@@ -341,6 +837,16 @@ void WhileStatement::Visit(ASTVisitor& visitor)
 void ForStatement::Visit(ASTVisitor& visitor)
 {
 	visitor.scope.enter();
+	if (counter && visitor.VisitCountedBound(counter->exposed))
+	{
+		std::any value;
+		auto begin = counter->begin->Eval(visitor);
+		visitor.VisitCountedForStart(counter->var, begin, counter->end->Eval(visitor), counter->inclusive, value);
+		body->Visit(visitor);
+		visitor.VisitCountedForEnd(value);
+		visitor.scope.exit();
+		return;
+	}
 	if (init) init->Visit(visitor);
 	std::any value;
 	if (condition) value = condition->Eval(visitor);
@@ -353,6 +859,7 @@ void ForStatement::Visit(ASTVisitor& visitor)
 
 void ForEachStatement::Visit(ASTVisitor& visitor)
 {
+	if (visitor.VisitForEach(*this)) return;
 	visitor.scope.enter();
 	auto value = iterable->Eval(visitor);
 	visitor.VisitForEachStart(type, def, value);
@@ -370,9 +877,32 @@ void BreakStatement::Visit(ASTVisitor& visitor)
 	visitor.VisitBreak();
 }
 
+void OutlinedStatement::Visit(ASTVisitor& visitor)
+{
+	if (visitor.VisitOutlined(*this)) return;
+	for (auto& s : statements) s->Visit(visitor);
+}
+
+std::unique_ptr<FunctionNode> OutlinedStatement::Extract(const std::vector<VarType>& types)
+{
+	std::vector<Variable> parameters;
+	for (std::size_t i = 0; i < arguments.size(); i++) parameters.emplace_back(arguments[i], types[i]);
+	return std::make_unique<FunctionNode>(name, std::nullopt, std::move(parameters), BlockNode(std::move(statements)));
+}
+
+void OutlinedStatement::Restore(FunctionNode& function)
+{
+	statements = std::move(function.body.statements);
+}
+
 void ExpressionNode::Visit(ASTVisitor&)
 {
-	throw std::exception("Invalid call");
+	throw std::runtime_error("Invalid call");
+}
+
+std::any ExpressionNode::Discard(ASTVisitor& visitor)
+{
+	return Eval(visitor);
 }
 
 void VarDef::Visit(ASTVisitor& visitor)
@@ -406,7 +936,12 @@ std::any CallExpr::Eval(ASTVisitor& visitor)
 
 std::any Increment::Eval(ASTVisitor& visitor)
 {
-	return visitor.VisitIncrement(expr->Eval(visitor), inv, pre);
+	return visitor.VisitIncrement(expr->Eval(visitor), inv, pre, false);
+}
+
+std::any Increment::Discard(ASTVisitor& visitor)
+{
+	return visitor.VisitIncrement(expr->Eval(visitor), inv, pre, true);
 }
 
 std::any MemberExpr::Eval(ASTVisitor& visitor)
@@ -416,11 +951,22 @@ std::any MemberExpr::Eval(ASTVisitor& visitor)
 
 std::any Assignment::Eval(ASTVisitor& visitor)
 {
-	return visitor.VisitAssignment(ref->Eval(visitor), op, expr->Eval(visitor));
+	return visitor.VisitAssignment(ref->Eval(visitor), op, expr->Eval(visitor), false);
+}
+
+std::any Assignment::Discard(ASTVisitor& visitor)
+{
+	return visitor.VisitAssignment(ref->Eval(visitor), op, expr->Eval(visitor), true);
 }
 
 std::any UnaryExpr::Eval(ASTVisitor& visitor)
 {
+	if (auto inner = dynamic_cast<UnaryExpr*>(expr.get()); inner && inner->op == op)
+	{
+		auto value = inner->expr->Eval(visitor);
+		if (visitor.VisitInvolution(op, value)) return value;
+		return visitor.VisitUnary(op, visitor.VisitUnary(op, value));
+	}
 	return visitor.VisitUnary(op, expr->Eval(visitor));
 }
 
@@ -459,3 +1005,170 @@ std::any InitializerList::Eval(ASTVisitor& visitor)
 	for (auto& a : initializers) values.push_back(a->Eval(visitor));
 	return visitor.VisitInitializerList(values);
 }
+
+class Ugc::Script::Outliner
+{
+	static constexpr std::size_t MAX_LENGTH = 32;
+
+	struct Container
+	{
+		std::vector<std::unique_ptr<StatementNode>>* statements;
+		const Container* parent;
+		std::size_t index;
+		std::size_t module;
+	};
+
+	struct Occurrence
+	{
+		const Container* container;
+		std::size_t begin, end;
+	};
+
+	struct Candidate
+	{
+		std::size_t cost;
+		std::vector<Occurrence> occurrences;
+	};
+
+	std::size_t threshold;
+	std::size_t module = 0;
+	std::deque<Container> containers;
+	std::map<std::size_t, Candidate> candidates;
+
+	static void Measure(const Occurrence& o, Fingerprint& fp)
+	{
+		fp.scope.enter();
+		for (auto i = o.begin; i < o.end; i++) (*o.container->statements)[i]->Visit(fp);
+	}
+
+	void Collect(StatementNode* s, const Container* parent, std::size_t index)
+	{
+		if (!s) return;
+		if (auto b = dynamic_cast<BlockNode*>(s)) Scan(b->statements, parent, index);
+		else if (auto i = dynamic_cast<IfStatement*>(s))
+		{
+			Collect(i->then.get(), parent, index);
+			Collect(i->otherwise.get(), parent, index);
+		}
+		else if (auto w = dynamic_cast<WhileStatement*>(s)) Collect(w->body.get(), parent, index);
+		else if (auto f = dynamic_cast<ForStatement*>(s)) Collect(f->body.get(), parent, index);
+		else if (auto fe = dynamic_cast<ForEachStatement*>(s)) Collect(fe->body.get(), parent, index);
+		else if (auto sw = dynamic_cast<SwitchStatement*>(s))
+		{
+			for (auto& c : sw->cases) Scan(c->statements, parent, index);
+			if (sw->default_case) Scan(sw->default_case->statements, parent, index);
+		}
+	}
+
+	void Scan(std::vector<std::unique_ptr<StatementNode>>& statements, const Container* parent, std::size_t index)
+	{
+		auto& container = containers.emplace_back(&statements, parent, index, module);
+		auto n = statements.size();
+		for (std::size_t k = 0; k < n; k++) Collect(statements[k].get(), &container, k);
+		std::vector<std::unordered_set<std::string>> after(n + 1);
+		for (auto k = n; k-- > 0;)
+		{
+			UsageInspector usage;
+			statements[k]->Visit(usage);
+			after[k] = after[k + 1];
+			after[k].insert_range(usage.reads);
+		}
+		for (std::size_t i = 0; i < n; i++)
+		{
+			Fingerprint fp;
+			fp.scope.enter();
+			for (auto j = i; j < n && j < i + MAX_LENGTH; j++)
+			{
+				statements[j]->Visit(fp);
+				if (fp.poisoned) break;
+				if (fp.cost < threshold || std::ranges::any_of(fp.declared, [&](const std::string& id) { return after[j + 1].contains(id); })) continue;
+				auto& candidate = candidates[std::hash<std::string>{}(fp.Render())];
+				candidate.cost = fp.cost;
+				candidate.occurrences.emplace_back(&container, i, j + 1);
+			}
+		}
+	}
+
+	static bool Inside(const Occurrence& a, const Occurrence& b)
+	{
+		for (auto c = a.container; c->parent; c = c->parent)
+		{
+			if (c->parent == b.container && c->index >= b.begin && c->index < b.end) return true;
+		}
+		return false;
+	}
+
+	static bool Conflicts(const Occurrence& a, const Occurrence& b)
+	{
+		if (a.container == b.container) return a.begin < b.end && b.begin < a.end;
+		return Inside(a, b) || Inside(b, a);
+	}
+public:
+	explicit Outliner(std::size_t threshold) : threshold(threshold) {}
+
+	std::vector<std::size_t> Run(const std::vector<ASTNode*>& modules)
+	{
+		for (module = 0; module < modules.size(); module++)
+		{
+			for (auto& d : static_cast<RootNode*>(modules[module])->declarations)
+			{
+				if (auto e = dynamic_cast<EventNode*>(d.get())) Scan(e->body.statements, nullptr, 0);
+				else if (auto f = dynamic_cast<FunctionNode*>(d.get()); f && !f->cost.has_value()) Scan(f->body.statements, nullptr, 0);
+			}
+		}
+		std::vector<std::pair<std::size_t, Candidate*>> order;
+		for (auto& [key, candidate] : candidates)
+		{
+			if (candidate.occurrences.size() > 1) order.emplace_back(candidate.cost * (candidate.occurrences.size() - 1), &candidate);
+		}
+		std::ranges::stable_sort(order, std::greater{}, &decltype(order)::value_type::first);
+		std::vector<const Occurrence*> chosen;
+		std::vector<std::pair<std::string, const Occurrence*>> replacements;
+		std::size_t groups = 0;
+		for (auto& [savings, candidate] : order)
+		{
+			std::optional<std::string> text;
+			std::vector<const Occurrence*> accepted;
+			for (auto& o : candidate->occurrences)
+			{
+				auto conflicts = [&](const Occurrence* other) { return Conflicts(o, *other); };
+				if (std::ranges::any_of(chosen, conflicts) || std::ranges::any_of(accepted, conflicts)) continue;
+				// candidates are bucketed by hash, so confirm the logs really match
+				Fingerprint fp;
+				Measure(o, fp);
+				auto render = fp.Render();
+				if (!text) text = std::move(render);
+				else if (render != *text) continue;
+				accepted.push_back(&o);
+			}
+			if (accepted.size() < 2) continue;
+			auto name = std::format("outline#{}", groups++);
+			for (auto o : accepted) replacements.emplace_back(name, o);
+			chosen.append_range(accepted);
+		}
+		std::ranges::stable_sort(replacements, std::greater{}, [](const auto& r) { return r.second->begin; });
+		std::vector<std::size_t> counts(modules.size());
+		for (auto& [name, o] : replacements)
+		{
+			++counts[o->container->module];
+			Fingerprint fp;
+			Measure(*o, fp);
+			auto& statements = *o->container->statements;
+			auto first = statements.begin() + o->begin, last = statements.begin() + o->end;
+			auto outlined = std::make_unique<OutlinedStatement>(name, std::vector<std::unique_ptr<StatementNode>>(std::make_move_iterator(first), std::make_move_iterator(last)));
+			outlined->arguments = fp.Arguments();
+			for (auto& a : outlined->arguments) outlined->written.push_back(fp.written.contains(a));
+			outlined->declared = std::move(fp.declared);
+			outlined->callees = std::move(fp.callees);
+			*first = std::move(outlined);
+			statements.erase(first + 1, last);
+		}
+		return counts;
+	}
+};
+
+std::vector<std::size_t> Ugc::Script::Outline(const std::vector<ASTNode*>& modules, std::size_t threshold)
+{
+	Trace::Span span("Outline");
+	return Outliner(threshold).Run(modules);
+}
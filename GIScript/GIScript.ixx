@@ -1,5 +1,9 @@
 module;
+#ifdef _MSC_VER
 #define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
 export module GIScript;
 
 import std;
@@ -23,9 +27,14 @@ export namespace Ugc::Script
 	};
 
 	class FunctionNode;
+	class GraphVarDef;
+	class ForStatement;
+	class OutlinedStatement;
+	class Outliner;
 
 	class RootNode : public ASTNode
 	{
+		friend Outliner;
 		std::vector<std::unique_ptr<DeclarationNode>> declarations;
 		std::vector<std::unique_ptr<FunctionNode>> global_functions;
 	public:
@@ -33,6 +42,7 @@ export namespace Ugc::Script
 		void Visit(ASTVisitor& visitor) override;
 
 		std::vector<std::unique_ptr<FunctionNode>> GlobalFunctions() { return std::move(global_functions); }
+		const std::vector<std::unique_ptr<DeclarationNode>>& Declarations() const { return declarations; }
 	};
 
 	class StatementNode : public ASTNode
@@ -62,15 +72,20 @@ export namespace Ugc::Script
 		ExpressionNode();
 
 		virtual std::any Eval(ASTVisitor& visitor) = 0;
+		virtual std::any Discard(ASTVisitor& visitor);
 	};
 
 	class BlockNode : public StatementNode
 	{
 		friend FunctionNode;
+		friend OutlinedStatement;
+		friend Outliner;
 		std::vector<std::unique_ptr<StatementNode>> statements;
 	public:
 		explicit BlockNode(std::vector<std::unique_ptr<StatementNode>> statements);
 		void Visit(ASTVisitor& visitor) override;
+
+		const std::vector<std::unique_ptr<StatementNode>>& Statements() const { return statements; }
 	};
 
 	enum class GuidEx
@@ -103,6 +118,8 @@ export namespace Ugc::Script
 		std::any extra;
 
 		EXPORT bool operator==(const VarType& other) const;
+		// stable textual form, equal for equal types
+		EXPORT std::string Key() const;
 	};
 
 	struct MapEx
@@ -126,32 +143,62 @@ export namespace Ugc::Script
 
 	class EventNode : public DeclarationNode
 	{
+		friend Outliner;
 		std::string event;
 		std::vector<Variable> parameters;
 		BlockNode body;
 	public:
 		EventNode(const std::string& event, std::vector<Variable> parameters, BlockNode body);
 		void Visit(ASTVisitor& visitor) override;
+		const std::string& Name() const { return event; }
 	};
 
 	class FunctionNode : public DeclarationNode
 	{
+	public:
+		enum Hint
+		{
+			Auto,
+			Inline,
+			NoInline
+		};
+	private:
+		friend OutlinedStatement;
+		friend Outliner;
 		std::string name;
 		std::vector<Variable> parameters;
 		std::optional<VarType> ret;
 		BlockNode body;
-	public:
-		FunctionNode(const std::string& name, std::optional<VarType> ret, std::vector<Variable> parameters, BlockNode body);
+		Hint hint;
+		std::optional<std::size_t> cost;
+		std::unordered_set<std::string> writes;
+		std::unordered_set<std::string> calls;
+		bool pure = false;
+		bool tail_return = false;
+	public:
+		FunctionNode(const std::string& name, std::optional<VarType> ret, std::vector<Variable> parameters, BlockNode body, Hint hint = Auto);
 		void Visit(ASTVisitor& visitor) override;
 
 		std::string Name() const { return name; }
 		const std::vector<Variable>& Parameters() const { return parameters; }
 		std::optional<VarType> Ret() const { return ret; }
 		void VisitBody(ASTVisitor& visitor) { body.Visit(visitor); }
+
+		Hint InlineHint() const { return hint; }
+		std::optional<std::size_t> InlineCost() const { return cost; }
+		bool Writes(const std::string& id) const { return writes.contains(id); }
+		// names the inlinable body calls, builtins included
+		const std::unordered_set<std::string>& Calls() const { return calls; }
+		bool Pure() const { return pure; }
+		bool TailReturn() const { return tail_return; }
+		std::any EvalInline(ASTVisitor& visitor);
+		// signature plus body lowering log, equal for functions that compile to the same graph
+		std::string Canonical();
 	};
 
 	class Return : public StatementNode
 	{
+		friend FunctionNode;
 		std::unique_ptr<ExpressionNode> expr;
 	public:
 		explicit Return(std::unique_ptr<ExpressionNode> expr = nullptr);
@@ -160,22 +207,37 @@ export namespace Ugc::Script
 
 	class VarDef : public StatementNode
 	{
+		friend GraphVarDef;
 		std::vector<Variable> vars;
 	public:
 		explicit VarDef(std::vector<Variable> vars);
 		void Visit(ASTVisitor& visitor) override;
+
+		const std::vector<Variable>& Vars() const { return vars; }
+	};
+
+	class GraphVarDef : public DeclarationNode
+	{
+		std::vector<Variable> vars;
+	public:
+		explicit GraphVarDef(VarDef def);
+		void Visit(ASTVisitor& visitor) override;
 	};
 
 	class ExprStatement : public StatementNode
 	{
+		friend FunctionNode;
 		std::unique_ptr<ExpressionNode> expr;
 	public:
 		explicit ExprStatement(std::unique_ptr<ExpressionNode> expr);
 		void Visit(ASTVisitor& visitor) override;
+
+		ExpressionNode* Expr() const { return expr.get(); }
 	};
 
 	class IfStatement : public StatementNode
 	{
+		friend Outliner;
 		std::unique_ptr<ExpressionNode> condition;
 		std::unique_ptr<StatementNode> then;
 		std::unique_ptr<StatementNode> otherwise;
@@ -183,6 +245,10 @@ export namespace Ugc::Script
 		IfStatement(std::unique_ptr<ExpressionNode> condition, std::unique_ptr<StatementNode> then, std::unique_ptr<StatementNode> otherwise = nullptr);
 		void Visit(ASTVisitor& visitor) override;
 
+		ExpressionNode* Condition() const { return condition.get(); }
+		StatementNode* Then() const { return then.get(); }
+		StatementNode* Otherwise() const { return otherwise.get(); }
+
 		enum Phase
 		{
 			Start,
@@ -196,6 +262,7 @@ export namespace Ugc::Script
 	class CaseNode : public ASTNode
 	{
 		friend SwitchStatement;
+		friend Outliner;
 		std::unique_ptr<ExpressionNode> literal;
 		std::vector<std::unique_ptr<StatementNode>> statements;
 
@@ -206,6 +273,7 @@ export namespace Ugc::Script
 
 	class SwitchStatement : public StatementNode
 	{
+		friend Outliner;
 		std::unique_ptr<ExpressionNode> expr;
 		std::vector<std::unique_ptr<CaseNode>> cases;
 		std::unique_ptr<CaseNode> default_case;
@@ -216,6 +284,7 @@ export namespace Ugc::Script
 
 	class WhileStatement : public StatementNode
 	{
+		friend Outliner;
 		std::unique_ptr<ExpressionNode> expr;
 		std::unique_ptr<StatementNode> body;
 	public:
@@ -225,10 +294,22 @@ export namespace Ugc::Script
 
 	class ForStatement : public StatementNode
 	{
+		friend Outliner;
+		struct Counter
+		{
+			std::string var;
+			ExpressionNode* begin;
+			ExpressionNode* end;
+			bool inclusive;
+			// names the bound reads while the body calls functions, which could write them if they are not locals
+			std::unordered_set<std::string> exposed;
+		};
+
 		std::unique_ptr<StatementNode> init;
 		std::unique_ptr<ExpressionNode> condition;
 		std::unique_ptr<StatementNode> iteration;
 		std::unique_ptr<StatementNode> body;
+		std::optional<Counter> counter;
 	public:
 		explicit ForStatement(std::unique_ptr<StatementNode> init, std::unique_ptr<ExpressionNode> condition, std::unique_ptr<StatementNode> iteration, std::unique_ptr<StatementNode> body);
 		void Visit(ASTVisitor& visitor) override;
@@ -236,6 +317,7 @@ export namespace Ugc::Script
 
 	class ForEachStatement : public StatementNode
 	{
+		friend Outliner;
 		VarType type;
 		std::string def;
 		std::unique_ptr<ExpressionNode> iterable;
@@ -243,6 +325,33 @@ export namespace Ugc::Script
 	public:
 		explicit ForEachStatement(VarType type, const std::string& def, std::unique_ptr<ExpressionNode> iterable, std::unique_ptr<StatementNode> body);
 		void Visit(ASTVisitor& visitor) override;
+
+		const VarType& DeclaredType() const { return type; }
+		const std::string& Var() const { return def; }
+		ExpressionNode* Iterable() const { return iterable.get(); }
+		StatementNode* Body() const { return body.get(); }
+	};
+
+	class OutlinedStatement : public StatementNode
+	{
+		friend Outliner;
+		std::string name;
+		std::vector<std::string> arguments;
+		std::vector<bool> written;
+		std::unordered_set<std::string> declared;
+		std::unordered_set<std::string> callees;
+		std::vector<std::unique_ptr<StatementNode>> statements;
+	public:
+		OutlinedStatement(const std::string& name, std::vector<std::unique_ptr<StatementNode>> statements);
+		void Visit(ASTVisitor& visitor) override;
+
+		const std::string& Name() const { return name; }
+		const std::vector<std::string>& Arguments() const { return arguments; }
+		bool MemberWritten(std::size_t index) const { return written[index]; }
+		const std::unordered_set<std::string>& Declared() const { return declared; }
+		const std::unordered_set<std::string>& Callees() const { return callees; }
+		std::unique_ptr<FunctionNode> Extract(const std::vector<VarType>& types);
+		void Restore(FunctionNode& function);
 	};
 
 	class Literal : public ExpressionNode
@@ -263,6 +372,9 @@ export namespace Ugc::Script
 	public:
 		Literal(Type type, std::any value);
 		std::any Eval(ASTVisitor& visitor) override;
+
+		Type LiteralType() const { return type; }
+		const std::any& Value() const { return value; }
 		Literal BitwiseNOT() const;
 		Literal LogicalNOT() const;
 		Literal Negate() const;
@@ -274,6 +386,8 @@ export namespace Ugc::Script
 	public:
 		explicit Identifier(const std::string& id);
 		std::any Eval(ASTVisitor& visitor) override;
+
+		const std::string& Id() const { return id; }
 	};
 
 	class CallExpr : public ExpressionNode
@@ -284,6 +398,9 @@ export namespace Ugc::Script
 	public:
 		CallExpr(std::unique_ptr<ExpressionNode> expr, std::vector<std::unique_ptr<ExpressionNode>> args, std::optional<VarType> type = {});
 		std::any Eval(ASTVisitor& visitor) override;
+
+		ExpressionNode* Callee() const { return expr.get(); }
+		const std::vector<std::unique_ptr<ExpressionNode>>& Args() const { return args; }
 	};
 
 	class Increment : public ExpressionNode
@@ -294,6 +411,10 @@ export namespace Ugc::Script
 	public:
 		Increment(std::unique_ptr<ExpressionNode> expr, bool inv, bool pre);
 		std::any Eval(ASTVisitor& visitor) override;
+		std::any Discard(ASTVisitor& visitor) override;
+
+		ExpressionNode* Target() const { return expr.get(); }
+		bool Decrement() const { return inv; }
 	};
 
 	class MemberExpr : public ExpressionNode
@@ -324,6 +445,11 @@ export namespace Ugc::Script
 	public:
 		Assignment(std::unique_ptr<ExpressionNode> ref, std::unique_ptr<ExpressionNode> expr, Op op);
 		std::any Eval(ASTVisitor& visitor) override;
+		std::any Discard(ASTVisitor& visitor) override;
+
+		ExpressionNode* Target() const { return ref.get(); }
+		ExpressionNode* Value() const { return expr.get(); }
+		Op Operator() const { return op; }
 	};
 
 	class UnaryExpr : public ExpressionNode
@@ -375,6 +501,10 @@ export namespace Ugc::Script
 	public:
 		BinaryExpr(Op op, std::unique_ptr<ExpressionNode> l, std::unique_ptr<ExpressionNode> r);
 		std::any Eval(ASTVisitor& visitor) override;
+
+		Op Operator() const { return op; }
+		ExpressionNode* Left() const { return l.get(); }
+		ExpressionNode* Right() const { return r.get(); }
 	};
 
 	class TernaryExpr : public ExpressionNode
@@ -450,6 +580,16 @@ export namespace Ugc::Script
 		void enter() { scopes.emplace_back(); }
 		void exit() { scopes.pop_back(); }
 
+		// hides every scope but the outermost one until resume() is called
+		std::vector<Scope> suspend()
+		{
+			std::vector<Scope> suspended(std::make_move_iterator(scopes.begin() + 1), std::make_move_iterator(scopes.end()));
+			scopes.erase(scopes.begin() + 1, scopes.end());
+			return suspended;
+		}
+
+		void resume(std::vector<Scope> suspended) { scopes.append_range(std::ranges::subrange(std::make_move_iterator(suspended.begin()), std::make_move_iterator(suspended.end()))); }
+
 		void add(const std::string& name, std::unique_ptr<LocalVar> value) { scopes.back()[name] = std::move(value); }
 
 		bool contains(const std::string& name) const { return scopes.back().contains(name); }
@@ -471,23 +611,33 @@ export namespace Ugc::Script
 
 		virtual void VisitEvent(const std::string& event, const std::vector<Variable>& parameters) {}
 		virtual void VisitFunction(const std::string& name, std::optional<VarType> ret, const std::vector<Variable>& parameters) {}
+		virtual bool VisitInlineFunction(FunctionNode& function) { return false; }
 		virtual void VisitVarDef(const std::string& id, VarType type, const std::any& value) {}
+		virtual void VisitGraphVarDef(const std::string& id, VarType type) {}
 		virtual void VisitExprStatement(const std::any& value) {}
 		virtual void VisitIfStatement(IfStatement::Phase phase, std::any& value) {}
 		virtual void VisitSwitchStatement(int count, std::any& value, bool end) {}
 		virtual void VisitCase(const std::any& literal, std::any& value) {}
 		virtual void VisitWhile(std::any& value, bool end) {}
 		virtual void VisitFor(std::any& value, bool end) {}
+		virtual void VisitCountedForStart(const std::string& var, const std::any& begin, const std::any& end, bool inclusive, std::any& value) {}
+		virtual void VisitCountedForEnd(std::any& value) {}
+		// whether a counted loop may read its bound once; false lowers it as a plain for loop
+		virtual bool VisitCountedBound(const std::unordered_set<std::string>& exposed) { return true; }
+		// lets the visitor lower the whole loop itself; the body is not visited when it returns true
+		virtual bool VisitForEach(ForEachStatement& statement) { return false; }
 		virtual void VisitForEachStart(VarType type, const std::string& var, std::any& value) {}
 		virtual void VisitForEachEnd(std::any& value) {}
 		virtual void VisitBreak() {}
+		virtual bool VisitOutlined(OutlinedStatement& statement) { return false; }
 		virtual void VisitReturn(const std::any& value) {}
 		virtual std::any VisitLiteral(Literal::Type type, const std::any& value) { return {}; }
-		virtual std::any VisitAssignment(const std::any& ref, Assignment::Op op, const std::any& value) { return {}; }
+		virtual std::any VisitAssignment(const std::any& ref, Assignment::Op op, const std::any& value, bool discard) { return {}; }
 		virtual std::any VisitCall(const std::any& value, const std::vector<std::any>& args, std::optional<VarType> type) { return {}; }
 		virtual std::any VisitIdentifier(const std::string& id) { return {}; }
-		virtual std::any VisitIncrement(const std::any& ref, bool inv, bool pre) { return {}; }
+		virtual std::any VisitIncrement(const std::any& ref, bool inv, bool pre, bool discard) { return {}; }
 		virtual std::any VisitMemberAccess(const std::any& value, const std::any& member, std::optional<VarType> type) { return {}; }
+		virtual bool VisitInvolution(UnaryExpr::Op op, const std::any& value) { return false; }
 		virtual std::any VisitUnary(UnaryExpr::Op op, const std::any& value) { return {}; }
 		virtual std::any VisitBinary(BinaryExpr::Op op, const std::any& l, const std::any& r) { return {}; }
 		virtual std::any VisitTernary(const std::any& e1, const std::any& e2, const std::any& e3) { return {}; }
@@ -499,6 +649,8 @@ export namespace Ugc::Script
 	};
 
 	EXPORT std::unique_ptr<ASTNode> Parse(const std::string& code);
+	// returns the number of sequences outlined in each module
+	EXPORT std::vector<std::size_t> Outline(const std::vector<ASTNode*>& modules, std::size_t threshold);
 }
 
 using namespace Ugc::Script;
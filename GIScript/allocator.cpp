@@ -0,0 +1,26 @@
+#include <cstdlib>
+#include <new>
+
+import memory_usage;
+
+// on Windows every binary has its own operator new, so this is built into each one that allocates for the compiler;
+// elsewhere the first definition the loader finds serves the whole process
+void* operator new(std::size_t size)
+{
+	auto p = std::malloc(size ? size : 1);
+	if (!p) throw std::bad_alloc();
+	Ugc::Memory::Allocated(p);
+	return p;
+}
+
+void operator delete(void* p) noexcept
+{
+	Ugc::Memory::Freed(p);
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	Ugc::Memory::Freed(p);
+	std::free(p);
+}
@@ -1,11 +1,11 @@
 grammar GIScript;
 
-program: (event | function)*;
+program: (event | function | varDef ';')*;
 
 event: 'event' ID '(' parameterList? ')' block;
 
 functionSign: ('void' | type) ID '(' parameterList? ')';
-function: 'global'? functionSign block;
+function: ('global' | ID)? functionSign block;
 
 parameterList: parameter (',' parameter)*;
 parameter: type ID;
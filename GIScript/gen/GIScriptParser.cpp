@@ -83,188 +83,189 @@ void giscriptParserInitialize() {
     }
   );
   static const int32_t serializedATNSegment[] = {
-  	4,1,76,537,2,0,7,0,2,1,7,1,2,2,7,2,2,3,7,3,2,4,7,4,2,5,7,5,2,6,7,6,2,
+  	4,1,76,539,2,0,7,0,2,1,7,1,2,2,7,2,2,3,7,3,2,4,7,4,2,5,7,5,2,6,7,6,2,
   	7,7,7,2,8,7,8,2,9,7,9,2,10,7,10,2,11,7,11,2,12,7,12,2,13,7,13,2,14,7,
   	14,2,15,7,15,2,16,7,16,2,17,7,17,2,18,7,18,2,19,7,19,2,20,7,20,2,21,7,
   	21,2,22,7,22,2,23,7,23,2,24,7,24,2,25,7,25,2,26,7,26,2,27,7,27,2,28,7,
   	28,2,29,7,29,2,30,7,30,2,31,7,31,2,32,7,32,2,33,7,33,2,34,7,34,2,35,7,
   	35,2,36,7,36,2,37,7,37,2,38,7,38,2,39,7,39,2,40,7,40,2,41,7,41,2,42,7,
-  	42,2,43,7,43,2,44,7,44,2,45,7,45,2,46,7,46,1,0,1,0,5,0,97,8,0,10,0,12,
-  	0,100,9,0,1,1,1,1,1,1,1,1,3,1,106,8,1,1,1,1,1,1,1,1,2,1,2,3,2,113,8,2,
-  	1,2,1,2,1,2,3,2,118,8,2,1,2,1,2,1,3,3,3,123,8,3,1,3,1,3,1,3,1,4,1,4,1,
-  	4,5,4,131,8,4,10,4,12,4,134,9,4,1,5,1,5,1,5,1,6,1,6,1,6,1,6,1,6,1,6,1,
-  	6,1,6,1,6,1,6,3,6,149,8,6,1,7,1,7,1,7,1,7,1,7,1,7,1,7,1,7,1,7,1,7,1,7,
-  	1,7,3,7,163,8,7,1,8,1,8,3,8,167,8,8,1,9,1,9,1,9,1,9,4,9,173,8,9,11,9,
-  	12,9,174,1,9,1,9,1,10,1,10,3,10,181,8,10,1,11,1,11,5,11,185,8,11,10,11,
-  	12,11,188,9,11,1,11,1,11,1,12,1,12,1,12,1,12,1,12,1,12,1,12,1,12,1,12,
-  	1,12,1,12,1,12,1,12,1,12,1,12,1,12,1,12,1,12,3,12,210,8,12,1,13,1,13,
-  	1,13,3,13,215,8,13,1,14,1,14,3,14,219,8,14,1,14,1,14,1,14,5,14,224,8,
-  	14,10,14,12,14,227,9,14,1,15,1,15,3,15,231,8,15,1,16,1,16,1,16,1,16,1,
-  	16,1,16,1,16,3,16,240,8,16,1,17,1,17,1,17,1,17,1,17,1,17,1,18,1,18,3,
-  	18,250,8,18,1,19,1,19,1,19,3,19,255,8,19,1,19,1,19,3,19,259,8,19,1,19,
-  	1,19,3,19,263,8,19,1,19,1,19,1,19,1,20,1,20,1,20,1,20,3,20,272,8,20,1,
-  	20,1,20,1,20,1,20,1,20,1,20,1,21,1,21,1,21,1,21,1,21,1,21,5,21,286,8,
-  	21,10,21,12,21,289,9,21,1,21,3,21,292,8,21,1,21,1,21,1,22,1,22,1,22,1,
-  	22,5,22,300,8,22,10,22,12,22,303,9,22,1,23,1,23,1,23,5,23,308,8,23,10,
-  	23,12,23,311,9,23,1,24,1,24,3,24,315,8,24,1,25,1,25,1,25,1,25,5,25,321,
-  	8,25,10,25,12,25,324,9,25,3,25,326,8,25,1,25,1,25,1,26,1,26,1,26,1,26,
-  	1,26,1,26,1,26,1,26,1,26,1,26,1,26,1,26,3,26,342,8,26,1,27,1,27,1,27,
-  	5,27,347,8,27,10,27,12,27,350,9,27,1,28,1,28,1,28,1,28,1,28,1,28,3,28,
-  	358,8,28,1,28,1,28,3,28,362,8,28,1,29,1,29,3,29,366,8,29,1,29,1,29,1,
-  	29,3,29,371,8,29,1,30,1,30,1,31,1,31,1,31,1,31,5,31,379,8,31,10,31,12,
-  	31,382,9,31,1,32,1,32,1,32,1,32,1,32,1,32,3,32,390,8,32,1,33,5,33,393,
-  	8,33,10,33,12,33,396,9,33,1,33,1,33,1,33,1,33,3,33,402,8,33,1,34,1,34,
-  	1,34,1,34,1,34,1,34,5,34,410,8,34,10,34,12,34,413,9,34,1,35,1,35,1,35,
-  	1,35,1,35,1,35,5,35,421,8,35,10,35,12,35,424,9,35,1,36,1,36,1,36,1,36,
-  	1,36,1,36,5,36,432,8,36,10,36,12,36,435,9,36,1,37,1,37,1,37,1,37,1,37,
-  	1,37,5,37,443,8,37,10,37,12,37,446,9,37,1,38,1,38,1,38,1,38,1,38,1,38,
-  	5,38,454,8,38,10,38,12,38,457,9,38,1,39,1,39,1,39,1,39,1,39,1,39,5,39,
-  	465,8,39,10,39,12,39,468,9,39,1,40,1,40,1,40,1,40,1,40,1,40,5,40,476,
-  	8,40,10,40,12,40,479,9,40,1,41,1,41,1,41,1,41,1,41,1,41,5,41,487,8,41,
-  	10,41,12,41,490,9,41,1,42,1,42,1,42,1,42,1,42,1,42,5,42,498,8,42,10,42,
-  	12,42,501,9,42,1,43,1,43,1,43,1,43,1,43,1,43,5,43,509,8,43,10,43,12,43,
-  	512,9,43,1,44,1,44,1,44,1,44,1,44,1,44,3,44,520,8,44,1,45,1,45,1,45,1,
-  	45,1,45,3,45,527,8,45,1,46,1,46,1,46,5,46,532,8,46,10,46,12,46,535,9,
-  	46,1,46,0,10,68,70,72,74,76,78,80,82,84,86,47,0,2,4,6,8,10,12,14,16,18,
-  	20,22,24,26,28,30,32,34,36,38,40,42,44,46,48,50,52,54,56,58,60,62,64,
-  	66,68,70,72,74,76,78,80,82,84,86,88,90,92,0,11,2,0,11,11,15,17,2,0,70,
-  	70,72,72,1,0,36,39,1,0,44,45,1,0,46,48,1,0,49,51,2,0,46,46,52,52,1,0,
-  	53,55,3,0,14,14,18,18,56,57,1,0,58,59,2,0,25,25,66,69,565,0,98,1,0,0,
-  	0,2,101,1,0,0,0,4,112,1,0,0,0,6,122,1,0,0,0,8,127,1,0,0,0,10,135,1,0,
-  	0,0,12,148,1,0,0,0,14,162,1,0,0,0,16,166,1,0,0,0,18,168,1,0,0,0,20,180,
-  	1,0,0,0,22,182,1,0,0,0,24,209,1,0,0,0,26,211,1,0,0,0,28,218,1,0,0,0,30,
-  	228,1,0,0,0,32,232,1,0,0,0,34,241,1,0,0,0,36,249,1,0,0,0,38,251,1,0,0,
-  	0,40,267,1,0,0,0,42,279,1,0,0,0,44,295,1,0,0,0,46,304,1,0,0,0,48,314,
-  	1,0,0,0,50,316,1,0,0,0,52,341,1,0,0,0,54,343,1,0,0,0,56,357,1,0,0,0,58,
-  	363,1,0,0,0,60,372,1,0,0,0,62,374,1,0,0,0,64,389,1,0,0,0,66,394,1,0,0,
-  	0,68,403,1,0,0,0,70,414,1,0,0,0,72,425,1,0,0,0,74,436,1,0,0,0,76,447,
-  	1,0,0,0,78,458,1,0,0,0,80,469,1,0,0,0,82,480,1,0,0,0,84,491,1,0,0,0,86,
-  	502,1,0,0,0,88,513,1,0,0,0,90,526,1,0,0,0,92,528,1,0,0,0,94,97,3,2,1,
-  	0,95,97,3,6,3,0,96,94,1,0,0,0,96,95,1,0,0,0,97,100,1,0,0,0,98,96,1,0,
-  	0,0,98,99,1,0,0,0,99,1,1,0,0,0,100,98,1,0,0,0,101,102,5,1,0,0,102,103,
-  	5,73,0,0,103,105,5,2,0,0,104,106,3,8,4,0,105,104,1,0,0,0,105,106,1,0,
-  	0,0,106,107,1,0,0,0,107,108,5,3,0,0,108,109,3,22,11,0,109,3,1,0,0,0,110,
-  	113,5,4,0,0,111,113,3,20,10,0,112,110,1,0,0,0,112,111,1,0,0,0,113,114,
-  	1,0,0,0,114,115,5,73,0,0,115,117,5,2,0,0,116,118,3,8,4,0,117,116,1,0,
-  	0,0,117,118,1,0,0,0,118,119,1,0,0,0,119,120,5,3,0,0,120,5,1,0,0,0,121,
-  	123,5,5,0,0,122,121,1,0,0,0,122,123,1,0,0,0,123,124,1,0,0,0,124,125,3,
-  	4,2,0,125,126,3,22,11,0,126,7,1,0,0,0,127,132,3,10,5,0,128,129,5,6,0,
-  	0,129,131,3,10,5,0,130,128,1,0,0,0,131,134,1,0,0,0,132,130,1,0,0,0,132,
-  	133,1,0,0,0,133,9,1,0,0,0,134,132,1,0,0,0,135,136,3,20,10,0,136,137,5,
-  	73,0,0,137,11,1,0,0,0,138,149,5,7,0,0,139,149,5,8,0,0,140,149,5,9,0,0,
-  	141,149,5,10,0,0,142,149,5,11,0,0,143,149,5,12,0,0,144,145,5,13,0,0,145,
-  	146,5,14,0,0,146,147,7,0,0,0,147,149,5,18,0,0,148,138,1,0,0,0,148,139,
-  	1,0,0,0,148,140,1,0,0,0,148,141,1,0,0,0,148,142,1,0,0,0,148,143,1,0,0,
-  	0,148,144,1,0,0,0,149,13,1,0,0,0,150,151,5,19,0,0,151,152,5,14,0,0,152,
-  	153,3,12,6,0,153,154,5,18,0,0,154,163,1,0,0,0,155,156,5,20,0,0,156,157,
-  	5,14,0,0,157,158,3,12,6,0,158,159,5,6,0,0,159,160,3,12,6,0,160,161,5,
-  	18,0,0,161,163,1,0,0,0,162,150,1,0,0,0,162,155,1,0,0,0,163,15,1,0,0,0,
-  	164,167,3,12,6,0,165,167,3,14,7,0,166,164,1,0,0,0,166,165,1,0,0,0,167,
-  	17,1,0,0,0,168,169,5,2,0,0,169,172,3,16,8,0,170,171,5,6,0,0,171,173,3,
-  	16,8,0,172,170,1,0,0,0,173,174,1,0,0,0,174,172,1,0,0,0,174,175,1,0,0,
-  	0,175,176,1,0,0,0,176,177,5,3,0,0,177,19,1,0,0,0,178,181,3,16,8,0,179,
-  	181,3,18,9,0,180,178,1,0,0,0,180,179,1,0,0,0,181,21,1,0,0,0,182,186,5,
-  	21,0,0,183,185,3,24,12,0,184,183,1,0,0,0,185,188,1,0,0,0,186,184,1,0,
-  	0,0,186,187,1,0,0,0,187,189,1,0,0,0,188,186,1,0,0,0,189,190,5,22,0,0,
-  	190,23,1,0,0,0,191,192,3,28,14,0,192,193,5,23,0,0,193,210,1,0,0,0,194,
-  	195,3,92,46,0,195,196,5,23,0,0,196,210,1,0,0,0,197,198,3,30,15,0,198,
-  	199,5,23,0,0,199,210,1,0,0,0,200,210,3,32,16,0,201,210,3,42,21,0,202,
-  	210,3,38,19,0,203,210,3,40,20,0,204,210,3,34,17,0,205,210,3,22,11,0,206,
-  	207,5,24,0,0,207,210,5,23,0,0,208,210,5,23,0,0,209,191,1,0,0,0,209,194,
-  	1,0,0,0,209,197,1,0,0,0,209,200,1,0,0,0,209,201,1,0,0,0,209,202,1,0,0,
-  	0,209,203,1,0,0,0,209,204,1,0,0,0,209,205,1,0,0,0,209,206,1,0,0,0,209,
-  	208,1,0,0,0,210,25,1,0,0,0,211,214,5,73,0,0,212,213,5,25,0,0,213,215,
-  	3,48,24,0,214,212,1,0,0,0,214,215,1,0,0,0,215,27,1,0,0,0,216,219,3,20,
-  	10,0,217,219,5,26,0,0,218,216,1,0,0,0,218,217,1,0,0,0,219,220,1,0,0,0,
-  	220,225,3,26,13,0,221,222,5,6,0,0,222,224,3,26,13,0,223,221,1,0,0,0,224,
-  	227,1,0,0,0,225,223,1,0,0,0,225,226,1,0,0,0,226,29,1,0,0,0,227,225,1,
-  	0,0,0,228,230,5,27,0,0,229,231,3,92,46,0,230,229,1,0,0,0,230,231,1,0,
-  	0,0,231,31,1,0,0,0,232,233,5,28,0,0,233,234,5,2,0,0,234,235,3,92,46,0,
-  	235,236,5,3,0,0,236,239,3,24,12,0,237,238,5,29,0,0,238,240,3,24,12,0,
-  	239,237,1,0,0,0,239,240,1,0,0,0,240,33,1,0,0,0,241,242,5,30,0,0,242,243,
-  	5,2,0,0,243,244,3,92,46,0,244,245,5,3,0,0,245,246,3,24,12,0,246,35,1,
-  	0,0,0,247,250,3,28,14,0,248,250,3,92,46,0,249,247,1,0,0,0,249,248,1,0,
-  	0,0,250,37,1,0,0,0,251,252,5,31,0,0,252,254,5,2,0,0,253,255,3,36,18,0,
-  	254,253,1,0,0,0,254,255,1,0,0,0,255,256,1,0,0,0,256,258,5,23,0,0,257,
-  	259,3,92,46,0,258,257,1,0,0,0,258,259,1,0,0,0,259,260,1,0,0,0,260,262,
-  	5,23,0,0,261,263,3,92,46,0,262,261,1,0,0,0,262,263,1,0,0,0,263,264,1,
-  	0,0,0,264,265,5,3,0,0,265,266,3,24,12,0,266,39,1,0,0,0,267,268,5,31,0,
-  	0,268,271,5,2,0,0,269,272,3,20,10,0,270,272,5,26,0,0,271,269,1,0,0,0,
-  	271,270,1,0,0,0,272,273,1,0,0,0,273,274,5,73,0,0,274,275,5,32,0,0,275,
-  	276,3,90,45,0,276,277,5,3,0,0,277,278,3,24,12,0,278,41,1,0,0,0,279,280,
-  	5,33,0,0,280,281,5,2,0,0,281,282,3,92,46,0,282,283,5,3,0,0,283,287,5,
-  	21,0,0,284,286,3,44,22,0,285,284,1,0,0,0,286,289,1,0,0,0,287,285,1,0,
-  	0,0,287,288,1,0,0,0,288,291,1,0,0,0,289,287,1,0,0,0,290,292,3,46,23,0,
-  	291,290,1,0,0,0,291,292,1,0,0,0,292,293,1,0,0,0,293,294,5,22,0,0,294,
-  	43,1,0,0,0,295,296,5,34,0,0,296,297,7,1,0,0,297,301,5,32,0,0,298,300,
-  	3,24,12,0,299,298,1,0,0,0,300,303,1,0,0,0,301,299,1,0,0,0,301,302,1,0,
-  	0,0,302,45,1,0,0,0,303,301,1,0,0,0,304,305,5,35,0,0,305,309,5,32,0,0,
-  	306,308,3,24,12,0,307,306,1,0,0,0,308,311,1,0,0,0,309,307,1,0,0,0,309,
-  	310,1,0,0,0,310,47,1,0,0,0,311,309,1,0,0,0,312,315,3,50,25,0,313,315,
-  	3,90,45,0,314,312,1,0,0,0,314,313,1,0,0,0,315,49,1,0,0,0,316,325,5,21,
-  	0,0,317,322,3,48,24,0,318,319,5,6,0,0,319,321,3,48,24,0,320,318,1,0,0,
-  	0,321,324,1,0,0,0,322,320,1,0,0,0,322,323,1,0,0,0,323,326,1,0,0,0,324,
-  	322,1,0,0,0,325,317,1,0,0,0,325,326,1,0,0,0,326,327,1,0,0,0,327,328,5,
-  	22,0,0,328,51,1,0,0,0,329,342,5,70,0,0,330,342,5,71,0,0,331,342,5,72,
-  	0,0,332,342,7,2,0,0,333,342,5,73,0,0,334,335,5,2,0,0,335,336,3,92,46,
-  	0,336,337,5,3,0,0,337,342,1,0,0,0,338,339,3,16,8,0,339,340,3,50,25,0,
-  	340,342,1,0,0,0,341,329,1,0,0,0,341,330,1,0,0,0,341,331,1,0,0,0,341,332,
-  	1,0,0,0,341,333,1,0,0,0,341,334,1,0,0,0,341,338,1,0,0,0,342,53,1,0,0,
-  	0,343,348,3,90,45,0,344,345,5,6,0,0,345,347,3,90,45,0,346,344,1,0,0,0,
-  	347,350,1,0,0,0,348,346,1,0,0,0,348,349,1,0,0,0,349,55,1,0,0,0,350,348,
-  	1,0,0,0,351,352,5,40,0,0,352,353,3,92,46,0,353,354,5,41,0,0,354,358,1,
-  	0,0,0,355,356,5,42,0,0,356,358,5,73,0,0,357,351,1,0,0,0,357,355,1,0,0,
-  	0,358,361,1,0,0,0,359,360,5,43,0,0,360,362,3,16,8,0,361,359,1,0,0,0,361,
-  	362,1,0,0,0,362,57,1,0,0,0,363,365,5,2,0,0,364,366,3,54,27,0,365,364,
-  	1,0,0,0,365,366,1,0,0,0,366,367,1,0,0,0,367,370,5,3,0,0,368,369,5,43,
-  	0,0,369,371,3,20,10,0,370,368,1,0,0,0,370,371,1,0,0,0,371,59,1,0,0,0,
-  	372,373,7,3,0,0,373,61,1,0,0,0,374,380,3,52,26,0,375,379,3,56,28,0,376,
-  	379,3,58,29,0,377,379,3,60,30,0,378,375,1,0,0,0,378,376,1,0,0,0,378,377,
-  	1,0,0,0,379,382,1,0,0,0,380,378,1,0,0,0,380,381,1,0,0,0,381,63,1,0,0,
-  	0,382,380,1,0,0,0,383,384,5,2,0,0,384,385,3,16,8,0,385,386,5,3,0,0,386,
-  	387,3,64,32,0,387,390,1,0,0,0,388,390,3,66,33,0,389,383,1,0,0,0,389,388,
-  	1,0,0,0,390,65,1,0,0,0,391,393,3,60,30,0,392,391,1,0,0,0,393,396,1,0,
-  	0,0,394,392,1,0,0,0,394,395,1,0,0,0,395,401,1,0,0,0,396,394,1,0,0,0,397,
-  	402,3,62,31,0,398,399,7,4,0,0,399,402,3,64,32,0,400,402,3,52,26,0,401,
-  	397,1,0,0,0,401,398,1,0,0,0,401,400,1,0,0,0,402,67,1,0,0,0,403,404,6,
-  	34,-1,0,404,405,3,64,32,0,405,411,1,0,0,0,406,407,10,2,0,0,407,408,7,
-  	5,0,0,408,410,3,64,32,0,409,406,1,0,0,0,410,413,1,0,0,0,411,409,1,0,0,
-  	0,411,412,1,0,0,0,412,69,1,0,0,0,413,411,1,0,0,0,414,415,6,35,-1,0,415,
-  	416,3,68,34,0,416,422,1,0,0,0,417,418,10,2,0,0,418,419,7,6,0,0,419,421,
-  	3,68,34,0,420,417,1,0,0,0,421,424,1,0,0,0,422,420,1,0,0,0,422,423,1,0,
-  	0,0,423,71,1,0,0,0,424,422,1,0,0,0,425,426,6,36,-1,0,426,427,3,70,35,
-  	0,427,433,1,0,0,0,428,429,10,2,0,0,429,430,7,7,0,0,430,432,3,70,35,0,
-  	431,428,1,0,0,0,432,435,1,0,0,0,433,431,1,0,0,0,433,434,1,0,0,0,434,73,
-  	1,0,0,0,435,433,1,0,0,0,436,437,6,37,-1,0,437,438,3,72,36,0,438,444,1,
-  	0,0,0,439,440,10,2,0,0,440,441,7,8,0,0,441,443,3,72,36,0,442,439,1,0,
-  	0,0,443,446,1,0,0,0,444,442,1,0,0,0,444,445,1,0,0,0,445,75,1,0,0,0,446,
-  	444,1,0,0,0,447,448,6,38,-1,0,448,449,3,74,37,0,449,455,1,0,0,0,450,451,
-  	10,2,0,0,451,452,7,9,0,0,452,454,3,74,37,0,453,450,1,0,0,0,454,457,1,
-  	0,0,0,455,453,1,0,0,0,455,456,1,0,0,0,456,77,1,0,0,0,457,455,1,0,0,0,
-  	458,459,6,39,-1,0,459,460,3,76,38,0,460,466,1,0,0,0,461,462,10,2,0,0,
-  	462,463,5,60,0,0,463,465,3,76,38,0,464,461,1,0,0,0,465,468,1,0,0,0,466,
-  	464,1,0,0,0,466,467,1,0,0,0,467,79,1,0,0,0,468,466,1,0,0,0,469,470,6,
-  	40,-1,0,470,471,3,78,39,0,471,477,1,0,0,0,472,473,10,2,0,0,473,474,5,
-  	61,0,0,474,476,3,78,39,0,475,472,1,0,0,0,476,479,1,0,0,0,477,475,1,0,
-  	0,0,477,478,1,0,0,0,478,81,1,0,0,0,479,477,1,0,0,0,480,481,6,41,-1,0,
-  	481,482,3,80,40,0,482,488,1,0,0,0,483,484,10,2,0,0,484,485,5,62,0,0,485,
-  	487,3,80,40,0,486,483,1,0,0,0,487,490,1,0,0,0,488,486,1,0,0,0,488,489,
-  	1,0,0,0,489,83,1,0,0,0,490,488,1,0,0,0,491,492,6,42,-1,0,492,493,3,82,
-  	41,0,493,499,1,0,0,0,494,495,10,2,0,0,495,496,5,63,0,0,496,498,3,82,41,
-  	0,497,494,1,0,0,0,498,501,1,0,0,0,499,497,1,0,0,0,499,500,1,0,0,0,500,
-  	85,1,0,0,0,501,499,1,0,0,0,502,503,6,43,-1,0,503,504,3,84,42,0,504,510,
-  	1,0,0,0,505,506,10,2,0,0,506,507,5,64,0,0,507,509,3,84,42,0,508,505,1,
-  	0,0,0,509,512,1,0,0,0,510,508,1,0,0,0,510,511,1,0,0,0,511,87,1,0,0,0,
-  	512,510,1,0,0,0,513,519,3,86,43,0,514,515,5,65,0,0,515,516,3,92,46,0,
-  	516,517,5,32,0,0,517,518,3,88,44,0,518,520,1,0,0,0,519,514,1,0,0,0,519,
-  	520,1,0,0,0,520,89,1,0,0,0,521,527,3,88,44,0,522,523,3,66,33,0,523,524,
-  	7,10,0,0,524,525,3,48,24,0,525,527,1,0,0,0,526,521,1,0,0,0,526,522,1,
-  	0,0,0,527,91,1,0,0,0,528,533,3,90,45,0,529,530,5,6,0,0,530,532,3,90,45,
-  	0,531,529,1,0,0,0,532,535,1,0,0,0,533,531,1,0,0,0,533,534,1,0,0,0,534,
-  	93,1,0,0,0,535,533,1,0,0,0,55,96,98,105,112,117,122,132,148,162,166,174,
-  	180,186,209,214,218,225,230,239,249,254,258,262,271,287,291,301,309,314,
-  	322,325,341,348,357,361,365,370,378,380,389,394,401,411,422,433,444,455,
-  	466,477,488,499,510,519,526,533
+  	42,2,43,7,43,2,44,7,44,2,45,7,45,2,46,7,46,1,0,1,0,1,0,1,0,5,0,99,8,0,
+  	10,0,12,0,102,9,0,1,1,1,1,1,1,1,1,3,1,108,8,1,1,1,1,1,1,1,1,2,1,2,3,2,
+  	115,8,2,1,2,1,2,1,2,3,2,120,8,2,1,2,1,2,1,3,3,3,125,8,3,1,3,1,3,1,3,1,
+  	4,1,4,1,4,5,4,133,8,4,10,4,12,4,136,9,4,1,5,1,5,1,5,1,6,1,6,1,6,1,6,1,
+  	6,1,6,1,6,1,6,1,6,1,6,3,6,151,8,6,1,7,1,7,1,7,1,7,1,7,1,7,1,7,1,7,1,7,
+  	1,7,1,7,1,7,3,7,165,8,7,1,8,1,8,3,8,169,8,8,1,9,1,9,1,9,1,9,4,9,175,8,
+  	9,11,9,12,9,176,1,9,1,9,1,10,1,10,3,10,183,8,10,1,11,1,11,5,11,187,8,
+  	11,10,11,12,11,190,9,11,1,11,1,11,1,12,1,12,1,12,1,12,1,12,1,12,1,12,
+  	1,12,1,12,1,12,1,12,1,12,1,12,1,12,1,12,1,12,1,12,1,12,3,12,212,8,12,
+  	1,13,1,13,1,13,3,13,217,8,13,1,14,1,14,3,14,221,8,14,1,14,1,14,1,14,5,
+  	14,226,8,14,10,14,12,14,229,9,14,1,15,1,15,3,15,233,8,15,1,16,1,16,1,
+  	16,1,16,1,16,1,16,1,16,3,16,242,8,16,1,17,1,17,1,17,1,17,1,17,1,17,1,
+  	18,1,18,3,18,252,8,18,1,19,1,19,1,19,3,19,257,8,19,1,19,1,19,3,19,261,
+  	8,19,1,19,1,19,3,19,265,8,19,1,19,1,19,1,19,1,20,1,20,1,20,1,20,3,20,
+  	274,8,20,1,20,1,20,1,20,1,20,1,20,1,20,1,21,1,21,1,21,1,21,1,21,1,21,
+  	5,21,288,8,21,10,21,12,21,291,9,21,1,21,3,21,294,8,21,1,21,1,21,1,22,
+  	1,22,1,22,1,22,5,22,302,8,22,10,22,12,22,305,9,22,1,23,1,23,1,23,5,23,
+  	310,8,23,10,23,12,23,313,9,23,1,24,1,24,3,24,317,8,24,1,25,1,25,1,25,
+  	1,25,5,25,323,8,25,10,25,12,25,326,9,25,3,25,328,8,25,1,25,1,25,1,26,
+  	1,26,1,26,1,26,1,26,1,26,1,26,1,26,1,26,1,26,1,26,1,26,3,26,344,8,26,
+  	1,27,1,27,1,27,5,27,349,8,27,10,27,12,27,352,9,27,1,28,1,28,1,28,1,28,
+  	1,28,1,28,3,28,360,8,28,1,28,1,28,3,28,364,8,28,1,29,1,29,3,29,368,8,
+  	29,1,29,1,29,1,29,3,29,373,8,29,1,30,1,30,1,31,1,31,1,31,1,31,5,31,381,
+  	8,31,10,31,12,31,384,9,31,1,32,1,32,1,32,1,32,1,32,1,32,3,32,392,8,32,
+  	1,33,5,33,395,8,33,10,33,12,33,398,9,33,1,33,1,33,1,33,1,33,3,33,404,
+  	8,33,1,34,1,34,1,34,1,34,1,34,1,34,5,34,412,8,34,10,34,12,34,415,9,34,
+  	1,35,1,35,1,35,1,35,1,35,1,35,5,35,423,8,35,10,35,12,35,426,9,35,1,36,
+  	1,36,1,36,1,36,1,36,1,36,5,36,434,8,36,10,36,12,36,437,9,36,1,37,1,37,
+  	1,37,1,37,1,37,1,37,5,37,445,8,37,10,37,12,37,448,9,37,1,38,1,38,1,38,
+  	1,38,1,38,1,38,5,38,456,8,38,10,38,12,38,459,9,38,1,39,1,39,1,39,1,39,
+  	1,39,1,39,5,39,467,8,39,10,39,12,39,470,9,39,1,40,1,40,1,40,1,40,1,40,
+  	1,40,5,40,478,8,40,10,40,12,40,481,9,40,1,41,1,41,1,41,1,41,1,41,1,41,
+  	5,41,489,8,41,10,41,12,41,492,9,41,1,42,1,42,1,42,1,42,1,42,1,42,5,42,
+  	500,8,42,10,42,12,42,503,9,42,1,43,1,43,1,43,1,43,1,43,1,43,5,43,511,
+  	8,43,10,43,12,43,514,9,43,1,44,1,44,1,44,1,44,1,44,1,44,3,44,522,8,44,
+  	1,45,1,45,1,45,1,45,1,45,3,45,529,8,45,1,46,1,46,1,46,5,46,534,8,46,10,
+  	46,12,46,537,9,46,1,46,0,10,68,70,72,74,76,78,80,82,84,86,47,0,2,4,6,
+  	8,10,12,14,16,18,20,22,24,26,28,30,32,34,36,38,40,42,44,46,48,50,52,54,
+  	56,58,60,62,64,66,68,70,72,74,76,78,80,82,84,86,88,90,92,0,12,2,0,5,5,
+  	73,73,2,0,11,11,15,17,2,0,70,70,72,72,1,0,36,39,1,0,44,45,1,0,46,48,1,
+  	0,49,51,2,0,46,46,52,52,1,0,53,55,3,0,14,14,18,18,56,57,1,0,58,59,2,0,
+  	25,25,66,69,568,94,99,3,2,1,0,95,99,3,6,3,0,96,97,3,28,14,0,97,99,5,23,
+  	0,0,98,94,1,0,0,0,98,95,1,0,0,0,98,96,1,0,0,0,99,102,1,0,0,0,100,98,1,
+  	0,0,0,100,101,1,0,0,0,101,1,1,0,0,0,102,100,1,0,0,0,0,98,1,0,0,0,2,103,
+  	1,0,0,0,4,114,1,0,0,0,6,124,1,0,0,0,8,129,1,0,0,0,10,137,1,0,0,0,12,150,
+  	1,0,0,0,14,164,1,0,0,0,16,168,1,0,0,0,18,170,1,0,0,0,20,182,1,0,0,0,22,
+  	184,1,0,0,0,24,211,1,0,0,0,26,213,1,0,0,0,28,220,1,0,0,0,30,230,1,0,0,
+  	0,32,234,1,0,0,0,34,243,1,0,0,0,36,251,1,0,0,0,38,253,1,0,0,0,40,269,
+  	1,0,0,0,42,281,1,0,0,0,44,297,1,0,0,0,46,306,1,0,0,0,48,316,1,0,0,0,50,
+  	318,1,0,0,0,52,343,1,0,0,0,54,345,1,0,0,0,56,359,1,0,0,0,58,365,1,0,0,
+  	0,60,374,1,0,0,0,62,376,1,0,0,0,64,391,1,0,0,0,66,396,1,0,0,0,68,405,
+  	1,0,0,0,70,416,1,0,0,0,72,427,1,0,0,0,74,438,1,0,0,0,76,449,1,0,0,0,78,
+  	460,1,0,0,0,80,471,1,0,0,0,82,482,1,0,0,0,84,493,1,0,0,0,86,504,1,0,0,
+  	0,88,515,1,0,0,0,90,528,1,0,0,0,92,530,1,0,0,0,103,104,5,1,0,0,104,105,
+  	5,73,0,0,105,107,5,2,0,0,106,108,3,8,4,0,107,106,1,0,0,0,107,108,1,0,
+  	0,0,108,109,1,0,0,0,109,110,5,3,0,0,110,111,3,22,11,0,111,3,1,0,0,0,112,
+  	115,5,4,0,0,113,115,3,20,10,0,114,112,1,0,0,0,114,113,1,0,0,0,115,116,
+  	1,0,0,0,116,117,5,73,0,0,117,119,5,2,0,0,118,120,3,8,4,0,119,118,1,0,
+  	0,0,119,120,1,0,0,0,120,121,1,0,0,0,121,122,5,3,0,0,122,5,1,0,0,0,123,
+  	125,7,0,0,0,124,123,1,0,0,0,124,125,1,0,0,0,125,126,1,0,0,0,126,127,3,
+  	4,2,0,127,128,3,22,11,0,128,7,1,0,0,0,129,134,3,10,5,0,130,131,5,6,0,
+  	0,131,133,3,10,5,0,132,130,1,0,0,0,133,136,1,0,0,0,134,132,1,0,0,0,134,
+  	135,1,0,0,0,135,9,1,0,0,0,136,134,1,0,0,0,137,138,3,20,10,0,138,139,5,
+  	73,0,0,139,11,1,0,0,0,140,151,5,7,0,0,141,151,5,8,0,0,142,151,5,9,0,0,
+  	143,151,5,10,0,0,144,151,5,11,0,0,145,151,5,12,0,0,146,147,5,13,0,0,147,
+  	148,5,14,0,0,148,149,7,1,0,0,149,151,5,18,0,0,150,140,1,0,0,0,150,141,
+  	1,0,0,0,150,142,1,0,0,0,150,143,1,0,0,0,150,144,1,0,0,0,150,145,1,0,0,
+  	0,150,146,1,0,0,0,151,13,1,0,0,0,152,153,5,19,0,0,153,154,5,14,0,0,154,
+  	155,3,12,6,0,155,156,5,18,0,0,156,165,1,0,0,0,157,158,5,20,0,0,158,159,
+  	5,14,0,0,159,160,3,12,6,0,160,161,5,6,0,0,161,162,3,12,6,0,162,163,5,
+  	18,0,0,163,165,1,0,0,0,164,152,1,0,0,0,164,157,1,0,0,0,165,15,1,0,0,0,
+  	166,169,3,12,6,0,167,169,3,14,7,0,168,166,1,0,0,0,168,167,1,0,0,0,169,
+  	17,1,0,0,0,170,171,5,2,0,0,171,174,3,16,8,0,172,173,5,6,0,0,173,175,3,
+  	16,8,0,174,172,1,0,0,0,175,176,1,0,0,0,176,174,1,0,0,0,176,177,1,0,0,
+  	0,177,178,1,0,0,0,178,179,5,3,0,0,179,19,1,0,0,0,180,183,3,16,8,0,181,
+  	183,3,18,9,0,182,180,1,0,0,0,182,181,1,0,0,0,183,21,1,0,0,0,184,188,5,
+  	21,0,0,185,187,3,24,12,0,186,185,1,0,0,0,187,190,1,0,0,0,188,186,1,0,
+  	0,0,188,189,1,0,0,0,189,191,1,0,0,0,190,188,1,0,0,0,191,192,5,22,0,0,
+  	192,23,1,0,0,0,193,194,3,28,14,0,194,195,5,23,0,0,195,212,1,0,0,0,196,
+  	197,3,92,46,0,197,198,5,23,0,0,198,212,1,0,0,0,199,200,3,30,15,0,200,
+  	201,5,23,0,0,201,212,1,0,0,0,202,212,3,32,16,0,203,212,3,42,21,0,204,
+  	212,3,38,19,0,205,212,3,40,20,0,206,212,3,34,17,0,207,212,3,22,11,0,208,
+  	209,5,24,0,0,209,212,5,23,0,0,210,212,5,23,0,0,211,193,1,0,0,0,211,196,
+  	1,0,0,0,211,199,1,0,0,0,211,202,1,0,0,0,211,203,1,0,0,0,211,204,1,0,0,
+  	0,211,205,1,0,0,0,211,206,1,0,0,0,211,207,1,0,0,0,211,208,1,0,0,0,211,
+  	210,1,0,0,0,212,25,1,0,0,0,213,216,5,73,0,0,214,215,5,25,0,0,215,217,
+  	3,48,24,0,216,214,1,0,0,0,216,217,1,0,0,0,217,27,1,0,0,0,218,221,3,20,
+  	10,0,219,221,5,26,0,0,220,218,1,0,0,0,220,219,1,0,0,0,221,222,1,0,0,0,
+  	222,227,3,26,13,0,223,224,5,6,0,0,224,226,3,26,13,0,225,223,1,0,0,0,226,
+  	229,1,0,0,0,227,225,1,0,0,0,227,228,1,0,0,0,228,29,1,0,0,0,229,227,1,
+  	0,0,0,230,232,5,27,0,0,231,233,3,92,46,0,232,231,1,0,0,0,232,233,1,0,
+  	0,0,233,31,1,0,0,0,234,235,5,28,0,0,235,236,5,2,0,0,236,237,3,92,46,0,
+  	237,238,5,3,0,0,238,241,3,24,12,0,239,240,5,29,0,0,240,242,3,24,12,0,
+  	241,239,1,0,0,0,241,242,1,0,0,0,242,33,1,0,0,0,243,244,5,30,0,0,244,245,
+  	5,2,0,0,245,246,3,92,46,0,246,247,5,3,0,0,247,248,3,24,12,0,248,35,1,
+  	0,0,0,249,252,3,28,14,0,250,252,3,92,46,0,251,249,1,0,0,0,251,250,1,0,
+  	0,0,252,37,1,0,0,0,253,254,5,31,0,0,254,256,5,2,0,0,255,257,3,36,18,0,
+  	256,255,1,0,0,0,256,257,1,0,0,0,257,258,1,0,0,0,258,260,5,23,0,0,259,
+  	261,3,92,46,0,260,259,1,0,0,0,260,261,1,0,0,0,261,262,1,0,0,0,262,264,
+  	5,23,0,0,263,265,3,92,46,0,264,263,1,0,0,0,264,265,1,0,0,0,265,266,1,
+  	0,0,0,266,267,5,3,0,0,267,268,3,24,12,0,268,39,1,0,0,0,269,270,5,31,0,
+  	0,270,273,5,2,0,0,271,274,3,20,10,0,272,274,5,26,0,0,273,271,1,0,0,0,
+  	273,272,1,0,0,0,274,275,1,0,0,0,275,276,5,73,0,0,276,277,5,32,0,0,277,
+  	278,3,90,45,0,278,279,5,3,0,0,279,280,3,24,12,0,280,41,1,0,0,0,281,282,
+  	5,33,0,0,282,283,5,2,0,0,283,284,3,92,46,0,284,285,5,3,0,0,285,289,5,
+  	21,0,0,286,288,3,44,22,0,287,286,1,0,0,0,288,291,1,0,0,0,289,287,1,0,
+  	0,0,289,290,1,0,0,0,290,293,1,0,0,0,291,289,1,0,0,0,292,294,3,46,23,0,
+  	293,292,1,0,0,0,293,294,1,0,0,0,294,295,1,0,0,0,295,296,5,22,0,0,296,
+  	43,1,0,0,0,297,298,5,34,0,0,298,299,7,2,0,0,299,303,5,32,0,0,300,302,
+  	3,24,12,0,301,300,1,0,0,0,302,305,1,0,0,0,303,301,1,0,0,0,303,304,1,0,
+  	0,0,304,45,1,0,0,0,305,303,1,0,0,0,306,307,5,35,0,0,307,311,5,32,0,0,
+  	308,310,3,24,12,0,309,308,1,0,0,0,310,313,1,0,0,0,311,309,1,0,0,0,311,
+  	312,1,0,0,0,312,47,1,0,0,0,313,311,1,0,0,0,314,317,3,50,25,0,315,317,
+  	3,90,45,0,316,314,1,0,0,0,316,315,1,0,0,0,317,49,1,0,0,0,318,327,5,21,
+  	0,0,319,324,3,48,24,0,320,321,5,6,0,0,321,323,3,48,24,0,322,320,1,0,0,
+  	0,323,326,1,0,0,0,324,322,1,0,0,0,324,325,1,0,0,0,325,328,1,0,0,0,326,
+  	324,1,0,0,0,327,319,1,0,0,0,327,328,1,0,0,0,328,329,1,0,0,0,329,330,5,
+  	22,0,0,330,51,1,0,0,0,331,344,5,70,0,0,332,344,5,71,0,0,333,344,5,72,
+  	0,0,334,344,7,3,0,0,335,344,5,73,0,0,336,337,5,2,0,0,337,338,3,92,46,
+  	0,338,339,5,3,0,0,339,344,1,0,0,0,340,341,3,16,8,0,341,342,3,50,25,0,
+  	342,344,1,0,0,0,343,331,1,0,0,0,343,332,1,0,0,0,343,333,1,0,0,0,343,334,
+  	1,0,0,0,343,335,1,0,0,0,343,336,1,0,0,0,343,340,1,0,0,0,344,53,1,0,0,
+  	0,345,350,3,90,45,0,346,347,5,6,0,0,347,349,3,90,45,0,348,346,1,0,0,0,
+  	349,352,1,0,0,0,350,348,1,0,0,0,350,351,1,0,0,0,351,55,1,0,0,0,352,350,
+  	1,0,0,0,353,354,5,40,0,0,354,355,3,92,46,0,355,356,5,41,0,0,356,360,1,
+  	0,0,0,357,358,5,42,0,0,358,360,5,73,0,0,359,353,1,0,0,0,359,357,1,0,0,
+  	0,360,363,1,0,0,0,361,362,5,43,0,0,362,364,3,16,8,0,363,361,1,0,0,0,363,
+  	364,1,0,0,0,364,57,1,0,0,0,365,367,5,2,0,0,366,368,3,54,27,0,367,366,
+  	1,0,0,0,367,368,1,0,0,0,368,369,1,0,0,0,369,372,5,3,0,0,370,371,5,43,
+  	0,0,371,373,3,20,10,0,372,370,1,0,0,0,372,373,1,0,0,0,373,59,1,0,0,0,
+  	374,375,7,4,0,0,375,61,1,0,0,0,376,382,3,52,26,0,377,381,3,56,28,0,378,
+  	381,3,58,29,0,379,381,3,60,30,0,380,377,1,0,0,0,380,378,1,0,0,0,380,379,
+  	1,0,0,0,381,384,1,0,0,0,382,380,1,0,0,0,382,383,1,0,0,0,383,63,1,0,0,
+  	0,384,382,1,0,0,0,385,386,5,2,0,0,386,387,3,16,8,0,387,388,5,3,0,0,388,
+  	389,3,64,32,0,389,392,1,0,0,0,390,392,3,66,33,0,391,385,1,0,0,0,391,390,
+  	1,0,0,0,392,65,1,0,0,0,393,395,3,60,30,0,394,393,1,0,0,0,395,398,1,0,
+  	0,0,396,394,1,0,0,0,396,397,1,0,0,0,397,403,1,0,0,0,398,396,1,0,0,0,399,
+  	404,3,62,31,0,400,401,7,5,0,0,401,404,3,64,32,0,402,404,3,52,26,0,403,
+  	399,1,0,0,0,403,400,1,0,0,0,403,402,1,0,0,0,404,67,1,0,0,0,405,406,6,
+  	34,-1,0,406,407,3,64,32,0,407,413,1,0,0,0,408,409,10,2,0,0,409,410,7,
+  	6,0,0,410,412,3,64,32,0,411,408,1,0,0,0,412,415,1,0,0,0,413,411,1,0,0,
+  	0,413,414,1,0,0,0,414,69,1,0,0,0,415,413,1,0,0,0,416,417,6,35,-1,0,417,
+  	418,3,68,34,0,418,424,1,0,0,0,419,420,10,2,0,0,420,421,7,7,0,0,421,423,
+  	3,68,34,0,422,419,1,0,0,0,423,426,1,0,0,0,424,422,1,0,0,0,424,425,1,0,
+  	0,0,425,71,1,0,0,0,426,424,1,0,0,0,427,428,6,36,-1,0,428,429,3,70,35,
+  	0,429,435,1,0,0,0,430,431,10,2,0,0,431,432,7,8,0,0,432,434,3,70,35,0,
+  	433,430,1,0,0,0,434,437,1,0,0,0,435,433,1,0,0,0,435,436,1,0,0,0,436,73,
+  	1,0,0,0,437,435,1,0,0,0,438,439,6,37,-1,0,439,440,3,72,36,0,440,446,1,
+  	0,0,0,441,442,10,2,0,0,442,443,7,9,0,0,443,445,3,72,36,0,444,441,1,0,
+  	0,0,445,448,1,0,0,0,446,444,1,0,0,0,446,447,1,0,0,0,447,75,1,0,0,0,448,
+  	446,1,0,0,0,449,450,6,38,-1,0,450,451,3,74,37,0,451,457,1,0,0,0,452,453,
+  	10,2,0,0,453,454,7,10,0,0,454,456,3,74,37,0,455,452,1,0,0,0,456,459,1,
+  	0,0,0,457,455,1,0,0,0,457,458,1,0,0,0,458,77,1,0,0,0,459,457,1,0,0,0,
+  	460,461,6,39,-1,0,461,462,3,76,38,0,462,468,1,0,0,0,463,464,10,2,0,0,
+  	464,465,5,60,0,0,465,467,3,76,38,0,466,463,1,0,0,0,467,470,1,0,0,0,468,
+  	466,1,0,0,0,468,469,1,0,0,0,469,79,1,0,0,0,470,468,1,0,0,0,471,472,6,
+  	40,-1,0,472,473,3,78,39,0,473,479,1,0,0,0,474,475,10,2,0,0,475,476,5,
+  	61,0,0,476,478,3,78,39,0,477,474,1,0,0,0,478,481,1,0,0,0,479,477,1,0,
+  	0,0,479,480,1,0,0,0,480,81,1,0,0,0,481,479,1,0,0,0,482,483,6,41,-1,0,
+  	483,484,3,80,40,0,484,490,1,0,0,0,485,486,10,2,0,0,486,487,5,62,0,0,487,
+  	489,3,80,40,0,488,485,1,0,0,0,489,492,1,0,0,0,490,488,1,0,0,0,490,491,
+  	1,0,0,0,491,83,1,0,0,0,492,490,1,0,0,0,493,494,6,42,-1,0,494,495,3,82,
+  	41,0,495,501,1,0,0,0,496,497,10,2,0,0,497,498,5,63,0,0,498,500,3,82,41,
+  	0,499,496,1,0,0,0,500,503,1,0,0,0,501,499,1,0,0,0,501,502,1,0,0,0,502,
+  	85,1,0,0,0,503,501,1,0,0,0,504,505,6,43,-1,0,505,506,3,84,42,0,506,512,
+  	1,0,0,0,507,508,10,2,0,0,508,509,5,64,0,0,509,511,3,84,42,0,510,507,1,
+  	0,0,0,511,514,1,0,0,0,512,510,1,0,0,0,512,513,1,0,0,0,513,87,1,0,0,0,
+  	514,512,1,0,0,0,515,521,3,86,43,0,516,517,5,65,0,0,517,518,3,92,46,0,
+  	518,519,5,32,0,0,519,520,3,88,44,0,520,522,1,0,0,0,521,516,1,0,0,0,521,
+  	522,1,0,0,0,522,89,1,0,0,0,523,529,3,88,44,0,524,525,3,66,33,0,525,526,
+  	7,11,0,0,526,527,3,48,24,0,527,529,1,0,0,0,528,523,1,0,0,0,528,524,1,
+  	0,0,0,529,91,1,0,0,0,530,535,3,90,45,0,531,532,5,6,0,0,532,534,3,90,45,
+  	0,533,531,1,0,0,0,534,537,1,0,0,0,535,533,1,0,0,0,535,536,1,0,0,0,536,
+  	93,1,0,0,0,537,535,1,0,0,0,55,98,100,107,114,119,124,134,150,164,168,
+  	176,182,188,211,216,220,227,232,241,251,256,260,264,273,289,293,303,311,
+  	316,324,327,343,350,359,363,367,372,380,382,391,396,403,413,424,435,446,
+  	457,468,479,490,501,512,521,528,535
   };
   staticData->serializedATN = antlr4::atn::SerializedATNView(serializedATNSegment, sizeof(serializedATNSegment) / sizeof(serializedATNSegment[0]));
 
@@ -335,6 +336,14 @@ GIScriptParser::FunctionContext* GIScriptParser::ProgramContext::function(size_t
   return getRuleContext<GIScriptParser::FunctionContext>(i);
 }
 
+std::vector<GIScriptParser::VarDefContext *> GIScriptParser::ProgramContext::varDef() {
+  return getRuleContexts<GIScriptParser::VarDefContext>();
+}
+
+GIScriptParser::VarDefContext* GIScriptParser::ProgramContext::varDef(size_t i) {
+  return getRuleContext<GIScriptParser::VarDefContext>(i);
+}
+
 
 size_t GIScriptParser::ProgramContext::getRuleIndex() const {
   return GIScriptParser::RuleProgram;
@@ -374,41 +383,38 @@ GIScriptParser::ProgramContext* GIScriptParser::program() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(98);
+    setState(100);
     _errHandler->sync(this);
     _la = _input->LA(1);
     while ((((_la & ~ 0x3fULL) == 0) &&
-      ((1ULL << _la) & 1589174) != 0)) {
-      setState(96);
+      ((1ULL << _la) & 68698038) != 0) || _la == GIScriptParser::ID) {
+      setState(98);
       _errHandler->sync(this);
-      switch (_input->LA(1)) {
-        case GIScriptParser::T__0: {
-          setState(94);
-          event();
-          break;
-        }
+      switch (getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 0, _ctx)) {
+      case 1: {
+        setState(94);
+        event();
+        break;
+      }
 
-        case GIScriptParser::T__1:
-        case GIScriptParser::T__3:
-        case GIScriptParser::T__4:
-        case GIScriptParser::T__6:
-        case GIScriptParser::T__7:
-        case GIScriptParser::T__8:
-        case GIScriptParser::T__9:
-        case GIScriptParser::T__10:
-        case GIScriptParser::T__11:
-        case GIScriptParser::T__12:
-        case GIScriptParser::T__18:
-        case GIScriptParser::T__19: {
-          setState(95);
-          function();
-          break;
-        }
+      case 2: {
+        setState(95);
+        function();
+        break;
+      }
+
+      case 3: {
+        setState(96);
+        varDef();
+        setState(97);
+        match(GIScriptParser::T__22);
+        break;
+      }
 
       default:
-        throw NoViableAltException(this);
+        break;
       }
-      setState(100);
+      setState(102);
       _errHandler->sync(this);
       _la = _input->LA(1);
     }
@@ -480,24 +486,24 @@ GIScriptParser::EventContext* GIScriptParser::event() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(101);
+    setState(103);
     match(GIScriptParser::T__0);
-    setState(102);
+    setState(104);
     match(GIScriptParser::ID);
-    setState(103);
-    match(GIScriptParser::T__1);
     setState(105);
+    match(GIScriptParser::T__1);
+    setState(107);
     _errHandler->sync(this);
 
     _la = _input->LA(1);
     if ((((_la & ~ 0x3fULL) == 0) &&
       ((1ULL << _la) & 1589124) != 0)) {
-      setState(104);
+      setState(106);
       parameterList();
     }
-    setState(107);
+    setState(109);
     match(GIScriptParser::T__2);
-    setState(108);
+    setState(110);
     block();
    
   }
@@ -567,11 +573,11 @@ GIScriptParser::FunctionSignContext* GIScriptParser::functionSign() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(112);
+    setState(114);
     _errHandler->sync(this);
     switch (_input->LA(1)) {
       case GIScriptParser::T__3: {
-        setState(110);
+        setState(112);
         match(GIScriptParser::T__3);
         break;
       }
@@ -586,7 +592,7 @@ GIScriptParser::FunctionSignContext* GIScriptParser::functionSign() {
       case GIScriptParser::T__12:
       case GIScriptParser::T__18:
       case GIScriptParser::T__19: {
-        setState(111);
+        setState(113);
         type();
         break;
       }
@@ -594,20 +600,20 @@ GIScriptParser::FunctionSignContext* GIScriptParser::functionSign() {
     default:
       throw NoViableAltException(this);
     }
-    setState(114);
+    setState(116);
     match(GIScriptParser::ID);
-    setState(115);
-    match(GIScriptParser::T__1);
     setState(117);
+    match(GIScriptParser::T__1);
+    setState(119);
     _errHandler->sync(this);
 
     _la = _input->LA(1);
     if ((((_la & ~ 0x3fULL) == 0) &&
       ((1ULL << _la) & 1589124) != 0)) {
-      setState(116);
+      setState(118);
       parameterList();
     }
-    setState(119);
+    setState(121);
     match(GIScriptParser::T__2);
    
   }
@@ -634,6 +640,10 @@ GIScriptParser::BlockContext* GIScriptParser::FunctionContext::block() {
   return getRuleContext<GIScriptParser::BlockContext>(0);
 }
 
+tree::TerminalNode* GIScriptParser::FunctionContext::ID() {
+  return getToken(GIScriptParser::ID, 0);
+}
+
 
 size_t GIScriptParser::FunctionContext::getRuleIndex() const {
   return GIScriptParser::RuleFunction;
@@ -673,17 +683,24 @@ GIScriptParser::FunctionContext* GIScriptParser::function() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(122);
+    setState(124);
     _errHandler->sync(this);
 
     _la = _input->LA(1);
-    if (_la == GIScriptParser::T__4) {
-      setState(121);
-      match(GIScriptParser::T__4);
+    if (_la == GIScriptParser::T__4 || _la == GIScriptParser::ID) {
+      setState(123);
+      _la = _input->LA(1);
+      if (!(_la == GIScriptParser::T__4 || _la == GIScriptParser::ID)) {
+      _errHandler->recoverInline(this);
+      }
+      else {
+        _errHandler->reportMatch(this);
+        consume();
+      }
     }
-    setState(124);
+    setState(126);
     functionSign();
-    setState(125);
+    setState(127);
     block();
    
   }
@@ -749,17 +766,17 @@ GIScriptParser::ParameterListContext* GIScriptParser::parameterList() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(127);
+    setState(129);
     parameter();
-    setState(132);
+    setState(134);
     _errHandler->sync(this);
     _la = _input->LA(1);
     while (_la == GIScriptParser::T__5) {
-      setState(128);
+      setState(130);
       match(GIScriptParser::T__5);
-      setState(129);
+      setState(131);
       parameter();
-      setState(134);
+      setState(136);
       _errHandler->sync(this);
       _la = _input->LA(1);
     }
@@ -826,9 +843,9 @@ GIScriptParser::ParameterContext* GIScriptParser::parameter() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(135);
+    setState(137);
     type();
-    setState(136);
+    setState(138);
     match(GIScriptParser::ID);
    
   }
@@ -885,58 +902,58 @@ GIScriptParser::BuiltinTypeContext* GIScriptParser::builtinType() {
     exitRule();
   });
   try {
-    setState(148);
+    setState(150);
     _errHandler->sync(this);
     switch (_input->LA(1)) {
       case GIScriptParser::T__6: {
         enterOuterAlt(_localctx, 1);
-        setState(138);
+        setState(140);
         match(GIScriptParser::T__6);
         break;
       }
 
       case GIScriptParser::T__7: {
         enterOuterAlt(_localctx, 2);
-        setState(139);
+        setState(141);
         match(GIScriptParser::T__7);
         break;
       }
 
       case GIScriptParser::T__8: {
         enterOuterAlt(_localctx, 3);
-        setState(140);
+        setState(142);
         match(GIScriptParser::T__8);
         break;
       }
 
       case GIScriptParser::T__9: {
         enterOuterAlt(_localctx, 4);
-        setState(141);
+        setState(143);
         match(GIScriptParser::T__9);
         break;
       }
 
       case GIScriptParser::T__10: {
         enterOuterAlt(_localctx, 5);
-        setState(142);
+        setState(144);
         match(GIScriptParser::T__10);
         break;
       }
 
       case GIScriptParser::T__11: {
         enterOuterAlt(_localctx, 6);
-        setState(143);
+        setState(145);
         match(GIScriptParser::T__11);
         break;
       }
 
       case GIScriptParser::T__12: {
         enterOuterAlt(_localctx, 7);
-        setState(144);
+        setState(146);
         match(GIScriptParser::T__12);
-        setState(145);
+        setState(147);
         match(GIScriptParser::T__13);
-        setState(146);
+        setState(148);
         antlrcpp::downCast<BuiltinTypeContext *>(_localctx)->con = _input->LT(1);
         _la = _input->LA(1);
         if (!((((_la & ~ 0x3fULL) == 0) &&
@@ -947,7 +964,7 @@ GIScriptParser::BuiltinTypeContext* GIScriptParser::builtinType() {
           _errHandler->reportMatch(this);
           consume();
         }
-        setState(147);
+        setState(149);
         match(GIScriptParser::T__17);
         break;
       }
@@ -1017,35 +1034,35 @@ GIScriptParser::GenericTypeContext* GIScriptParser::genericType() {
     exitRule();
   });
   try {
-    setState(162);
+    setState(164);
     _errHandler->sync(this);
     switch (_input->LA(1)) {
       case GIScriptParser::T__18: {
         enterOuterAlt(_localctx, 1);
-        setState(150);
+        setState(152);
         match(GIScriptParser::T__18);
-        setState(151);
+        setState(153);
         match(GIScriptParser::T__13);
-        setState(152);
+        setState(154);
         antlrcpp::downCast<GenericTypeContext *>(_localctx)->t = builtinType();
-        setState(153);
+        setState(155);
         match(GIScriptParser::T__17);
         break;
       }
 
       case GIScriptParser::T__19: {
         enterOuterAlt(_localctx, 2);
-        setState(155);
+        setState(157);
         match(GIScriptParser::T__19);
-        setState(156);
+        setState(158);
         match(GIScriptParser::T__13);
-        setState(157);
+        setState(159);
         antlrcpp::downCast<GenericTypeContext *>(_localctx)->k = builtinType();
-        setState(158);
+        setState(160);
         match(GIScriptParser::T__5);
-        setState(159);
+        setState(161);
         antlrcpp::downCast<GenericTypeContext *>(_localctx)->v = builtinType();
-        setState(160);
+        setState(162);
         match(GIScriptParser::T__17);
         break;
       }
@@ -1115,7 +1132,7 @@ GIScriptParser::SingleTypeContext* GIScriptParser::singleType() {
     exitRule();
   });
   try {
-    setState(166);
+    setState(168);
     _errHandler->sync(this);
     switch (_input->LA(1)) {
       case GIScriptParser::T__6:
@@ -1126,7 +1143,7 @@ GIScriptParser::SingleTypeContext* GIScriptParser::singleType() {
       case GIScriptParser::T__11:
       case GIScriptParser::T__12: {
         enterOuterAlt(_localctx, 1);
-        setState(164);
+        setState(166);
         builtinType();
         break;
       }
@@ -1134,7 +1151,7 @@ GIScriptParser::SingleTypeContext* GIScriptParser::singleType() {
       case GIScriptParser::T__18:
       case GIScriptParser::T__19: {
         enterOuterAlt(_localctx, 2);
-        setState(165);
+        setState(167);
         genericType();
         break;
       }
@@ -1206,23 +1223,23 @@ GIScriptParser::TupleContext* GIScriptParser::tuple() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(168);
+    setState(170);
     match(GIScriptParser::T__1);
-    setState(169);
+    setState(171);
     singleType();
-    setState(172); 
+    setState(174); 
     _errHandler->sync(this);
     _la = _input->LA(1);
     do {
-      setState(170);
+      setState(172);
       match(GIScriptParser::T__5);
-      setState(171);
+      setState(173);
       singleType();
-      setState(174); 
+      setState(176); 
       _errHandler->sync(this);
       _la = _input->LA(1);
     } while (_la == GIScriptParser::T__5);
-    setState(176);
+    setState(178);
     match(GIScriptParser::T__2);
    
   }
@@ -1286,7 +1303,7 @@ GIScriptParser::TypeContext* GIScriptParser::type() {
     exitRule();
   });
   try {
-    setState(180);
+    setState(182);
     _errHandler->sync(this);
     switch (_input->LA(1)) {
       case GIScriptParser::T__6:
@@ -1299,14 +1316,14 @@ GIScriptParser::TypeContext* GIScriptParser::type() {
       case GIScriptParser::T__18:
       case GIScriptParser::T__19: {
         enterOuterAlt(_localctx, 1);
-        setState(178);
+        setState(180);
         singleType();
         break;
       }
 
       case GIScriptParser::T__1: {
         enterOuterAlt(_localctx, 2);
-        setState(179);
+        setState(181);
         tuple();
         break;
       }
@@ -1378,21 +1395,21 @@ GIScriptParser::BlockContext* GIScriptParser::block() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(182);
+    setState(184);
     match(GIScriptParser::T__20);
-    setState(186);
+    setState(188);
     _errHandler->sync(this);
     _la = _input->LA(1);
     while ((((_la & ~ 0x3fULL) == 0) &&
       ((1ULL << _la) & 546400869302148) != 0) || ((((_la - 70) & ~ 0x3fULL) == 0) &&
       ((1ULL << (_la - 70)) & 15) != 0)) {
-      setState(183);
+      setState(185);
       statement();
-      setState(188);
+      setState(190);
       _errHandler->sync(this);
       _la = _input->LA(1);
     }
-    setState(189);
+    setState(191);
     match(GIScriptParser::T__21);
    
   }
@@ -1484,90 +1501,90 @@ GIScriptParser::StatementContext* GIScriptParser::statement() {
     exitRule();
   });
   try {
-    setState(209);
+    setState(211);
     _errHandler->sync(this);
     switch (getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 13, _ctx)) {
     case 1: {
       enterOuterAlt(_localctx, 1);
-      setState(191);
+      setState(193);
       varDef();
-      setState(192);
+      setState(194);
       match(GIScriptParser::T__22);
       break;
     }
 
     case 2: {
       enterOuterAlt(_localctx, 2);
-      setState(194);
+      setState(196);
       expr();
-      setState(195);
+      setState(197);
       match(GIScriptParser::T__22);
       break;
     }
 
     case 3: {
       enterOuterAlt(_localctx, 3);
-      setState(197);
+      setState(199);
       return_();
-      setState(198);
+      setState(200);
       match(GIScriptParser::T__22);
       break;
     }
 
     case 4: {
       enterOuterAlt(_localctx, 4);
-      setState(200);
+      setState(202);
       if_();
       break;
     }
 
     case 5: {
       enterOuterAlt(_localctx, 5);
-      setState(201);
+      setState(203);
       switch_();
       break;
     }
 
     case 6: {
       enterOuterAlt(_localctx, 6);
-      setState(202);
+      setState(204);
       for_();
       break;
     }
 
     case 7: {
       enterOuterAlt(_localctx, 7);
-      setState(203);
+      setState(205);
       forEach();
       break;
     }
 
     case 8: {
       enterOuterAlt(_localctx, 8);
-      setState(204);
+      setState(206);
       while_();
       break;
     }
 
     case 9: {
       enterOuterAlt(_localctx, 9);
-      setState(205);
+      setState(207);
       block();
       break;
     }
 
     case 10: {
       enterOuterAlt(_localctx, 10);
-      setState(206);
+      setState(208);
       match(GIScriptParser::T__23);
-      setState(207);
+      setState(209);
       match(GIScriptParser::T__22);
       break;
     }
 
     case 11: {
       enterOuterAlt(_localctx, 11);
-      setState(208);
+      setState(210);
       match(GIScriptParser::T__22);
       break;
     }
@@ -1639,16 +1656,16 @@ GIScriptParser::VarInitContext* GIScriptParser::varInit() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(211);
+    setState(213);
     match(GIScriptParser::ID);
-    setState(214);
+    setState(216);
     _errHandler->sync(this);
 
     _la = _input->LA(1);
     if (_la == GIScriptParser::T__24) {
-      setState(212);
+      setState(214);
       match(GIScriptParser::T__24);
-      setState(213);
+      setState(215);
       initializer();
     }
    
@@ -1719,7 +1736,7 @@ GIScriptParser::VarDefContext* GIScriptParser::varDef() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(218);
+    setState(220);
     _errHandler->sync(this);
     switch (_input->LA(1)) {
       case GIScriptParser::T__1:
@@ -1732,13 +1749,13 @@ GIScriptParser::VarDefContext* GIScriptParser::varDef() {
       case GIScriptParser::T__12:
       case GIScriptParser::T__18:
       case GIScriptParser::T__19: {
-        setState(216);
+        setState(218);
         type();
         break;
       }
 
       case GIScriptParser::T__25: {
-        setState(217);
+        setState(219);
         match(GIScriptParser::T__25);
         break;
       }
@@ -1746,17 +1763,17 @@ GIScriptParser::VarDefContext* GIScriptParser::varDef() {
     default:
       throw NoViableAltException(this);
     }
-    setState(220);
+    setState(222);
     varInit();
-    setState(225);
+    setState(227);
     _errHandler->sync(this);
     _la = _input->LA(1);
     while (_la == GIScriptParser::T__5) {
-      setState(221);
+      setState(223);
       match(GIScriptParser::T__5);
-      setState(222);
+      setState(224);
       varInit();
-      setState(227);
+      setState(229);
       _errHandler->sync(this);
       _la = _input->LA(1);
     }
@@ -1820,16 +1837,16 @@ GIScriptParser::ReturnContext* GIScriptParser::return_() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(228);
-    match(GIScriptParser::T__26);
     setState(230);
+    match(GIScriptParser::T__26);
+    setState(232);
     _errHandler->sync(this);
 
     _la = _input->LA(1);
     if ((((_la & ~ 0x3fULL) == 0) &&
       ((1ULL << _la) & 546388561117060) != 0) || ((((_la - 70) & ~ 0x3fULL) == 0) &&
       ((1ULL << (_la - 70)) & 15) != 0)) {
-      setState(229);
+      setState(231);
       expr();
     }
    
@@ -1899,24 +1916,24 @@ GIScriptParser::IfContext* GIScriptParser::if_() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(232);
+    setState(234);
     match(GIScriptParser::T__27);
-    setState(233);
+    setState(235);
     match(GIScriptParser::T__1);
-    setState(234);
+    setState(236);
     expr();
-    setState(235);
+    setState(237);
     match(GIScriptParser::T__2);
-    setState(236);
+    setState(238);
     antlrcpp::downCast<IfContext *>(_localctx)->then = statement();
-    setState(239);
+    setState(241);
     _errHandler->sync(this);
 
     switch (getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 18, _ctx)) {
     case 1: {
-      setState(237);
+      setState(239);
       match(GIScriptParser::T__28);
-      setState(238);
+      setState(240);
       antlrcpp::downCast<IfContext *>(_localctx)->else_ = statement();
       break;
     }
@@ -1987,15 +2004,15 @@ GIScriptParser::WhileContext* GIScriptParser::while_() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(241);
+    setState(243);
     match(GIScriptParser::T__29);
-    setState(242);
+    setState(244);
     match(GIScriptParser::T__1);
-    setState(243);
+    setState(245);
     expr();
-    setState(244);
+    setState(246);
     match(GIScriptParser::T__2);
-    setState(245);
+    setState(247);
     statement();
    
   }
@@ -2059,19 +2076,19 @@ GIScriptParser::ForInitContext* GIScriptParser::forInit() {
     exitRule();
   });
   try {
-    setState(249);
+    setState(251);
     _errHandler->sync(this);
     switch (getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 19, _ctx)) {
     case 1: {
       enterOuterAlt(_localctx, 1);
-      setState(247);
+      setState(249);
       varDef();
       break;
     }
 
     case 2: {
       enterOuterAlt(_localctx, 2);
-      setState(248);
+      setState(250);
       expr();
       break;
     }
@@ -2151,47 +2168,47 @@ GIScriptParser::ForContext* GIScriptParser::for_() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(251);
+    setState(253);
     match(GIScriptParser::T__30);
-    setState(252);
-    match(GIScriptParser::T__1);
     setState(254);
+    match(GIScriptParser::T__1);
+    setState(256);
     _errHandler->sync(this);
 
     _la = _input->LA(1);
     if ((((_la & ~ 0x3fULL) == 0) &&
       ((1ULL << _la) & 546388628225924) != 0) || ((((_la - 70) & ~ 0x3fULL) == 0) &&
       ((1ULL << (_la - 70)) & 15) != 0)) {
-      setState(253);
+      setState(255);
       forInit();
     }
-    setState(256);
-    match(GIScriptParser::T__22);
     setState(258);
+    match(GIScriptParser::T__22);
+    setState(260);
     _errHandler->sync(this);
 
     _la = _input->LA(1);
     if ((((_la & ~ 0x3fULL) == 0) &&
       ((1ULL << _la) & 546388561117060) != 0) || ((((_la - 70) & ~ 0x3fULL) == 0) &&
       ((1ULL << (_la - 70)) & 15) != 0)) {
-      setState(257);
+      setState(259);
       antlrcpp::downCast<ForContext *>(_localctx)->cond = expr();
     }
-    setState(260);
-    match(GIScriptParser::T__22);
     setState(262);
+    match(GIScriptParser::T__22);
+    setState(264);
     _errHandler->sync(this);
 
     _la = _input->LA(1);
     if ((((_la & ~ 0x3fULL) == 0) &&
       ((1ULL << _la) & 546388561117060) != 0) || ((((_la - 70) & ~ 0x3fULL) == 0) &&
       ((1ULL << (_la - 70)) & 15) != 0)) {
-      setState(261);
+      setState(263);
       antlrcpp::downCast<ForContext *>(_localctx)->it = expr();
     }
-    setState(264);
+    setState(266);
     match(GIScriptParser::T__2);
-    setState(265);
+    setState(267);
     statement();
    
   }
@@ -2264,11 +2281,11 @@ GIScriptParser::ForEachContext* GIScriptParser::forEach() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(267);
+    setState(269);
     match(GIScriptParser::T__30);
-    setState(268);
+    setState(270);
     match(GIScriptParser::T__1);
-    setState(271);
+    setState(273);
     _errHandler->sync(this);
     switch (_input->LA(1)) {
       case GIScriptParser::T__1:
@@ -2281,13 +2298,13 @@ GIScriptParser::ForEachContext* GIScriptParser::forEach() {
       case GIScriptParser::T__12:
       case GIScriptParser::T__18:
       case GIScriptParser::T__19: {
-        setState(269);
+        setState(271);
         type();
         break;
       }
 
       case GIScriptParser::T__25: {
-        setState(270);
+        setState(272);
         match(GIScriptParser::T__25);
         break;
       }
@@ -2295,15 +2312,15 @@ GIScriptParser::ForEachContext* GIScriptParser::forEach() {
     default:
       throw NoViableAltException(this);
     }
-    setState(273);
+    setState(275);
     match(GIScriptParser::ID);
-    setState(274);
+    setState(276);
     match(GIScriptParser::T__31);
-    setState(275);
+    setState(277);
     assignment();
-    setState(276);
+    setState(278);
     match(GIScriptParser::T__2);
-    setState(277);
+    setState(279);
     statement();
    
   }
@@ -2377,35 +2394,35 @@ GIScriptParser::SwitchContext* GIScriptParser::switch_() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(279);
+    setState(281);
     match(GIScriptParser::T__32);
-    setState(280);
+    setState(282);
     match(GIScriptParser::T__1);
-    setState(281);
+    setState(283);
     expr();
-    setState(282);
+    setState(284);
     match(GIScriptParser::T__2);
-    setState(283);
+    setState(285);
     match(GIScriptParser::T__20);
-    setState(287);
+    setState(289);
     _errHandler->sync(this);
     _la = _input->LA(1);
     while (_la == GIScriptParser::T__33) {
-      setState(284);
+      setState(286);
       case_();
-      setState(289);
+      setState(291);
       _errHandler->sync(this);
       _la = _input->LA(1);
     }
-    setState(291);
+    setState(293);
     _errHandler->sync(this);
 
     _la = _input->LA(1);
     if (_la == GIScriptParser::T__34) {
-      setState(290);
+      setState(292);
       default_();
     }
-    setState(293);
+    setState(295);
     match(GIScriptParser::T__21);
    
   }
@@ -2479,9 +2496,9 @@ GIScriptParser::CaseContext* GIScriptParser::case_() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(295);
+    setState(297);
     match(GIScriptParser::T__33);
-    setState(296);
+    setState(298);
     _la = _input->LA(1);
     if (!(_la == GIScriptParser::INT_DEF
 
@@ -2492,17 +2509,17 @@ GIScriptParser::CaseContext* GIScriptParser::case_() {
       _errHandler->reportMatch(this);
       consume();
     }
-    setState(297);
+    setState(299);
     match(GIScriptParser::T__31);
-    setState(301);
+    setState(303);
     _errHandler->sync(this);
     _la = _input->LA(1);
     while ((((_la & ~ 0x3fULL) == 0) &&
       ((1ULL << _la) & 546400869302148) != 0) || ((((_la - 70) & ~ 0x3fULL) == 0) &&
       ((1ULL << (_la - 70)) & 15) != 0)) {
-      setState(298);
+      setState(300);
       statement();
-      setState(303);
+      setState(305);
       _errHandler->sync(this);
       _la = _input->LA(1);
     }
@@ -2570,19 +2587,19 @@ GIScriptParser::DefaultContext* GIScriptParser::default_() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(304);
+    setState(306);
     match(GIScriptParser::T__34);
-    setState(305);
+    setState(307);
     match(GIScriptParser::T__31);
-    setState(309);
+    setState(311);
     _errHandler->sync(this);
     _la = _input->LA(1);
     while ((((_la & ~ 0x3fULL) == 0) &&
       ((1ULL << _la) & 546400869302148) != 0) || ((((_la - 70) & ~ 0x3fULL) == 0) &&
       ((1ULL << (_la - 70)) & 15) != 0)) {
-      setState(306);
+      setState(308);
       statement();
-      setState(311);
+      setState(313);
       _errHandler->sync(this);
       _la = _input->LA(1);
     }
@@ -2648,12 +2665,12 @@ GIScriptParser::InitializerContext* GIScriptParser::initializer() {
     exitRule();
   });
   try {
-    setState(314);
+    setState(316);
     _errHandler->sync(this);
     switch (_input->LA(1)) {
       case GIScriptParser::T__20: {
         enterOuterAlt(_localctx, 1);
-        setState(312);
+        setState(314);
         initializerList();
         break;
       }
@@ -2682,7 +2699,7 @@ GIScriptParser::InitializerContext* GIScriptParser::initializer() {
       case GIScriptParser::STRING_DEF:
       case GIScriptParser::ID: {
         enterOuterAlt(_localctx, 2);
-        setState(313);
+        setState(315);
         assignment();
         break;
       }
@@ -2754,31 +2771,31 @@ GIScriptParser::InitializerListContext* GIScriptParser::initializerList() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(316);
+    setState(318);
     match(GIScriptParser::T__20);
-    setState(325);
+    setState(327);
     _errHandler->sync(this);
 
     _la = _input->LA(1);
     if ((((_la & ~ 0x3fULL) == 0) &&
       ((1ULL << _la) & 546388563214212) != 0) || ((((_la - 70) & ~ 0x3fULL) == 0) &&
       ((1ULL << (_la - 70)) & 15) != 0)) {
-      setState(317);
+      setState(319);
       initializer();
-      setState(322);
+      setState(324);
       _errHandler->sync(this);
       _la = _input->LA(1);
       while (_la == GIScriptParser::T__5) {
-        setState(318);
+        setState(320);
         match(GIScriptParser::T__5);
-        setState(319);
+        setState(321);
         initializer();
-        setState(324);
+        setState(326);
         _errHandler->sync(this);
         _la = _input->LA(1);
       }
     }
-    setState(327);
+    setState(329);
     match(GIScriptParser::T__21);
    
   }
@@ -2994,13 +3011,13 @@ GIScriptParser::PrimaryContext* GIScriptParser::primary() {
     exitRule();
   });
   try {
-    setState(341);
+    setState(343);
     _errHandler->sync(this);
     switch (_input->LA(1)) {
       case GIScriptParser::INT_DEF: {
         _localctx = _tracker.createInstance<GIScriptParser::IntegerLiteralContext>(_localctx);
         enterOuterAlt(_localctx, 1);
-        setState(329);
+        setState(331);
         match(GIScriptParser::INT_DEF);
         break;
       }
@@ -3008,7 +3025,7 @@ GIScriptParser::PrimaryContext* GIScriptParser::primary() {
       case GIScriptParser::FLOAT_DEF: {
         _localctx = _tracker.createInstance<GIScriptParser::FloatLiteralContext>(_localctx);
         enterOuterAlt(_localctx, 2);
-        setState(330);
+        setState(332);
         match(GIScriptParser::FLOAT_DEF);
         break;
       }
@@ -3016,7 +3033,7 @@ GIScriptParser::PrimaryContext* GIScriptParser::primary() {
       case GIScriptParser::STRING_DEF: {
         _localctx = _tracker.createInstance<GIScriptParser::StringLiteralContext>(_localctx);
         enterOuterAlt(_localctx, 3);
-        setState(331);
+        setState(333);
         match(GIScriptParser::STRING_DEF);
         break;
       }
@@ -3027,7 +3044,7 @@ GIScriptParser::PrimaryContext* GIScriptParser::primary() {
       case GIScriptParser::T__38: {
         _localctx = _tracker.createInstance<GIScriptParser::KeywordLiteralContext>(_localctx);
         enterOuterAlt(_localctx, 4);
-        setState(332);
+        setState(334);
         _la = _input->LA(1);
         if (!((((_la & ~ 0x3fULL) == 0) &&
           ((1ULL << _la) & 1030792151040) != 0))) {
@@ -3043,7 +3060,7 @@ GIScriptParser::PrimaryContext* GIScriptParser::primary() {
       case GIScriptParser::ID: {
         _localctx = _tracker.createInstance<GIScriptParser::IdentifierLiteralContext>(_localctx);
         enterOuterAlt(_localctx, 5);
-        setState(333);
+        setState(335);
         match(GIScriptParser::ID);
         break;
       }
@@ -3051,11 +3068,11 @@ GIScriptParser::PrimaryContext* GIScriptParser::primary() {
       case GIScriptParser::T__1: {
         _localctx = _tracker.createInstance<GIScriptParser::ParenExpressionContext>(_localctx);
         enterOuterAlt(_localctx, 6);
-        setState(334);
+        setState(336);
         match(GIScriptParser::T__1);
-        setState(335);
+        setState(337);
         expr();
-        setState(336);
+        setState(338);
         match(GIScriptParser::T__2);
         break;
       }
@@ -3071,9 +3088,9 @@ GIScriptParser::PrimaryContext* GIScriptParser::primary() {
       case GIScriptParser::T__19: {
         _localctx = _tracker.createInstance<GIScriptParser::TypeInitializerContext>(_localctx);
         enterOuterAlt(_localctx, 7);
-        setState(338);
+        setState(340);
         singleType();
-        setState(339);
+        setState(341);
         initializerList();
         break;
       }
@@ -3145,17 +3162,17 @@ GIScriptParser::ArgumentListContext* GIScriptParser::argumentList() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(343);
+    setState(345);
     assignment();
-    setState(348);
+    setState(350);
     _errHandler->sync(this);
     _la = _input->LA(1);
     while (_la == GIScriptParser::T__5) {
-      setState(344);
+      setState(346);
       match(GIScriptParser::T__5);
-      setState(345);
+      setState(347);
       assignment();
-      setState(350);
+      setState(352);
       _errHandler->sync(this);
       _la = _input->LA(1);
     }
@@ -3226,23 +3243,23 @@ GIScriptParser::MemberAccessContext* GIScriptParser::memberAccess() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(357);
+    setState(359);
     _errHandler->sync(this);
     switch (_input->LA(1)) {
       case GIScriptParser::T__39: {
-        setState(351);
+        setState(353);
         match(GIScriptParser::T__39);
-        setState(352);
+        setState(354);
         expr();
-        setState(353);
+        setState(355);
         match(GIScriptParser::T__40);
         break;
       }
 
       case GIScriptParser::T__41: {
-        setState(355);
+        setState(357);
         match(GIScriptParser::T__41);
-        setState(356);
+        setState(358);
         match(GIScriptParser::ID);
         break;
       }
@@ -3250,14 +3267,14 @@ GIScriptParser::MemberAccessContext* GIScriptParser::memberAccess() {
     default:
       throw NoViableAltException(this);
     }
-    setState(361);
+    setState(363);
     _errHandler->sync(this);
 
     switch (getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 34, _ctx)) {
     case 1: {
-      setState(359);
+      setState(361);
       match(GIScriptParser::T__42);
-      setState(360);
+      setState(362);
       singleType();
       break;
     }
@@ -3329,28 +3346,28 @@ GIScriptParser::FunctionCallContext* GIScriptParser::functionCall() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(363);
-    match(GIScriptParser::T__1);
     setState(365);
+    match(GIScriptParser::T__1);
+    setState(367);
     _errHandler->sync(this);
 
     _la = _input->LA(1);
     if ((((_la & ~ 0x3fULL) == 0) &&
       ((1ULL << _la) & 546388561117060) != 0) || ((((_la - 70) & ~ 0x3fULL) == 0) &&
       ((1ULL << (_la - 70)) & 15) != 0)) {
-      setState(364);
+      setState(366);
       argumentList();
     }
-    setState(367);
+    setState(369);
     match(GIScriptParser::T__2);
-    setState(370);
+    setState(372);
     _errHandler->sync(this);
 
     switch (getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 36, _ctx)) {
     case 1: {
-      setState(368);
+      setState(370);
       match(GIScriptParser::T__42);
-      setState(369);
+      setState(371);
       type();
       break;
     }
@@ -3414,7 +3431,7 @@ GIScriptParser::IncrementContext* GIScriptParser::increment() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(372);
+    setState(374);
     _la = _input->LA(1);
     if (!(_la == GIScriptParser::T__43
 
@@ -3509,32 +3526,32 @@ GIScriptParser::PostfixContext* GIScriptParser::postfix() {
   try {
     size_t alt;
     enterOuterAlt(_localctx, 1);
-    setState(374);
+    setState(376);
     primary();
-    setState(380);
+    setState(382);
     _errHandler->sync(this);
     alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 38, _ctx);
     while (alt != 2 && alt != atn::ATN::INVALID_ALT_NUMBER) {
       if (alt == 1) {
-        setState(378);
+        setState(380);
         _errHandler->sync(this);
         switch (_input->LA(1)) {
           case GIScriptParser::T__39:
           case GIScriptParser::T__41: {
-            setState(375);
+            setState(377);
             memberAccess();
             break;
           }
 
           case GIScriptParser::T__1: {
-            setState(376);
+            setState(378);
             functionCall();
             break;
           }
 
           case GIScriptParser::T__43:
           case GIScriptParser::T__44: {
-            setState(377);
+            setState(379);
             increment();
             break;
           }
@@ -3543,7 +3560,7 @@ GIScriptParser::PostfixContext* GIScriptParser::postfix() {
           throw NoViableAltException(this);
         } 
       }
-      setState(382);
+      setState(384);
       _errHandler->sync(this);
       alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 38, _ctx);
     }
@@ -3613,25 +3630,25 @@ GIScriptParser::CastContext* GIScriptParser::cast() {
     exitRule();
   });
   try {
-    setState(389);
+    setState(391);
     _errHandler->sync(this);
     switch (getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 39, _ctx)) {
     case 1: {
       enterOuterAlt(_localctx, 1);
-      setState(383);
+      setState(385);
       match(GIScriptParser::T__1);
-      setState(384);
+      setState(386);
       singleType();
-      setState(385);
+      setState(387);
       match(GIScriptParser::T__2);
-      setState(386);
+      setState(388);
       cast();
       break;
     }
 
     case 2: {
       enterOuterAlt(_localctx, 2);
-      setState(388);
+      setState(390);
       unary();
       break;
     }
@@ -3715,29 +3732,29 @@ GIScriptParser::UnaryContext* GIScriptParser::unary() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(394);
+    setState(396);
     _errHandler->sync(this);
     _la = _input->LA(1);
     while (_la == GIScriptParser::T__43
 
     || _la == GIScriptParser::T__44) {
-      setState(391);
+      setState(393);
       increment();
-      setState(396);
+      setState(398);
       _errHandler->sync(this);
       _la = _input->LA(1);
     }
-    setState(401);
+    setState(403);
     _errHandler->sync(this);
     switch (getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 41, _ctx)) {
     case 1: {
-      setState(397);
+      setState(399);
       postfix();
       break;
     }
 
     case 2: {
-      setState(398);
+      setState(400);
       antlrcpp::downCast<UnaryContext *>(_localctx)->op = _input->LT(1);
       _la = _input->LA(1);
       if (!((((_la & ~ 0x3fULL) == 0) &&
@@ -3748,13 +3765,13 @@ GIScriptParser::UnaryContext* GIScriptParser::unary() {
         _errHandler->reportMatch(this);
         consume();
       }
-      setState(399);
+      setState(401);
       cast();
       break;
     }
 
     case 3: {
-      setState(400);
+      setState(402);
       primary();
       break;
     }
@@ -3838,10 +3855,10 @@ GIScriptParser::MultiplicativeContext* GIScriptParser::multiplicative(int preced
   try {
     size_t alt;
     enterOuterAlt(_localctx, 1);
-    setState(404);
+    setState(406);
     cast();
     _ctx->stop = _input->LT(-1);
-    setState(411);
+    setState(413);
     _errHandler->sync(this);
     alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 42, _ctx);
     while (alt != 2 && alt != atn::ATN::INVALID_ALT_NUMBER) {
@@ -3851,10 +3868,10 @@ GIScriptParser::MultiplicativeContext* GIScriptParser::multiplicative(int preced
         previousContext = _localctx;
         _localctx = _tracker.createInstance<MultiplicativeContext>(parentContext, parentState);
         pushNewRecursionContext(_localctx, startState, RuleMultiplicative);
-        setState(406);
+        setState(408);
 
         if (!(precpred(_ctx, 2))) throw FailedPredicateException(this, "precpred(_ctx, 2)");
-        setState(407);
+        setState(409);
         antlrcpp::downCast<MultiplicativeContext *>(_localctx)->op = _input->LT(1);
         _la = _input->LA(1);
         if (!((((_la & ~ 0x3fULL) == 0) &&
@@ -3865,10 +3882,10 @@ GIScriptParser::MultiplicativeContext* GIScriptParser::multiplicative(int preced
           _errHandler->reportMatch(this);
           consume();
         }
-        setState(408);
+        setState(410);
         cast(); 
       }
-      setState(413);
+      setState(415);
       _errHandler->sync(this);
       alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 42, _ctx);
     }
@@ -3946,10 +3963,10 @@ GIScriptParser::AdditiveContext* GIScriptParser::additive(int precedence) {
   try {
     size_t alt;
     enterOuterAlt(_localctx, 1);
-    setState(415);
+    setState(417);
     multiplicative(0);
     _ctx->stop = _input->LT(-1);
-    setState(422);
+    setState(424);
     _errHandler->sync(this);
     alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 43, _ctx);
     while (alt != 2 && alt != atn::ATN::INVALID_ALT_NUMBER) {
@@ -3959,10 +3976,10 @@ GIScriptParser::AdditiveContext* GIScriptParser::additive(int precedence) {
         previousContext = _localctx;
         _localctx = _tracker.createInstance<AdditiveContext>(parentContext, parentState);
         pushNewRecursionContext(_localctx, startState, RuleAdditive);
-        setState(417);
+        setState(419);
 
         if (!(precpred(_ctx, 2))) throw FailedPredicateException(this, "precpred(_ctx, 2)");
-        setState(418);
+        setState(420);
         antlrcpp::downCast<AdditiveContext *>(_localctx)->op = _input->LT(1);
         _la = _input->LA(1);
         if (!(_la == GIScriptParser::T__45
@@ -3974,10 +3991,10 @@ GIScriptParser::AdditiveContext* GIScriptParser::additive(int precedence) {
           _errHandler->reportMatch(this);
           consume();
         }
-        setState(419);
+        setState(421);
         multiplicative(0); 
       }
-      setState(424);
+      setState(426);
       _errHandler->sync(this);
       alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 43, _ctx);
     }
@@ -4055,10 +4072,10 @@ GIScriptParser::ShiftContext* GIScriptParser::shift(int precedence) {
   try {
     size_t alt;
     enterOuterAlt(_localctx, 1);
-    setState(426);
+    setState(428);
     additive(0);
     _ctx->stop = _input->LT(-1);
-    setState(433);
+    setState(435);
     _errHandler->sync(this);
     alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 44, _ctx);
     while (alt != 2 && alt != atn::ATN::INVALID_ALT_NUMBER) {
@@ -4068,10 +4085,10 @@ GIScriptParser::ShiftContext* GIScriptParser::shift(int precedence) {
         previousContext = _localctx;
         _localctx = _tracker.createInstance<ShiftContext>(parentContext, parentState);
         pushNewRecursionContext(_localctx, startState, RuleShift);
-        setState(428);
+        setState(430);
 
         if (!(precpred(_ctx, 2))) throw FailedPredicateException(this, "precpred(_ctx, 2)");
-        setState(429);
+        setState(431);
         antlrcpp::downCast<ShiftContext *>(_localctx)->op = _input->LT(1);
         _la = _input->LA(1);
         if (!((((_la & ~ 0x3fULL) == 0) &&
@@ -4082,10 +4099,10 @@ GIScriptParser::ShiftContext* GIScriptParser::shift(int precedence) {
           _errHandler->reportMatch(this);
           consume();
         }
-        setState(430);
+        setState(432);
         additive(0); 
       }
-      setState(435);
+      setState(437);
       _errHandler->sync(this);
       alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 44, _ctx);
     }
@@ -4163,10 +4180,10 @@ GIScriptParser::RelationalContext* GIScriptParser::relational(int precedence) {
   try {
     size_t alt;
     enterOuterAlt(_localctx, 1);
-    setState(437);
+    setState(439);
     shift(0);
     _ctx->stop = _input->LT(-1);
-    setState(444);
+    setState(446);
     _errHandler->sync(this);
     alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 45, _ctx);
     while (alt != 2 && alt != atn::ATN::INVALID_ALT_NUMBER) {
@@ -4176,10 +4193,10 @@ GIScriptParser::RelationalContext* GIScriptParser::relational(int precedence) {
         previousContext = _localctx;
         _localctx = _tracker.createInstance<RelationalContext>(parentContext, parentState);
         pushNewRecursionContext(_localctx, startState, RuleRelational);
-        setState(439);
+        setState(441);
 
         if (!(precpred(_ctx, 2))) throw FailedPredicateException(this, "precpred(_ctx, 2)");
-        setState(440);
+        setState(442);
         antlrcpp::downCast<RelationalContext *>(_localctx)->op = _input->LT(1);
         _la = _input->LA(1);
         if (!((((_la & ~ 0x3fULL) == 0) &&
@@ -4190,10 +4207,10 @@ GIScriptParser::RelationalContext* GIScriptParser::relational(int precedence) {
           _errHandler->reportMatch(this);
           consume();
         }
-        setState(441);
+        setState(443);
         shift(0); 
       }
-      setState(446);
+      setState(448);
       _errHandler->sync(this);
       alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 45, _ctx);
     }
@@ -4271,10 +4288,10 @@ GIScriptParser::EqualityContext* GIScriptParser::equality(int precedence) {
   try {
     size_t alt;
     enterOuterAlt(_localctx, 1);
-    setState(448);
+    setState(450);
     relational(0);
     _ctx->stop = _input->LT(-1);
-    setState(455);
+    setState(457);
     _errHandler->sync(this);
     alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 46, _ctx);
     while (alt != 2 && alt != atn::ATN::INVALID_ALT_NUMBER) {
@@ -4284,10 +4301,10 @@ GIScriptParser::EqualityContext* GIScriptParser::equality(int precedence) {
         previousContext = _localctx;
         _localctx = _tracker.createInstance<EqualityContext>(parentContext, parentState);
         pushNewRecursionContext(_localctx, startState, RuleEquality);
-        setState(450);
+        setState(452);
 
         if (!(precpred(_ctx, 2))) throw FailedPredicateException(this, "precpred(_ctx, 2)");
-        setState(451);
+        setState(453);
         antlrcpp::downCast<EqualityContext *>(_localctx)->op = _input->LT(1);
         _la = _input->LA(1);
         if (!(_la == GIScriptParser::T__57
@@ -4299,10 +4316,10 @@ GIScriptParser::EqualityContext* GIScriptParser::equality(int precedence) {
           _errHandler->reportMatch(this);
           consume();
         }
-        setState(452);
+        setState(454);
         relational(0); 
       }
-      setState(457);
+      setState(459);
       _errHandler->sync(this);
       alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 46, _ctx);
     }
@@ -4380,10 +4397,10 @@ GIScriptParser::AndContext* GIScriptParser::and_(int precedence) {
   try {
     size_t alt;
     enterOuterAlt(_localctx, 1);
-    setState(459);
+    setState(461);
     equality(0);
     _ctx->stop = _input->LT(-1);
-    setState(466);
+    setState(468);
     _errHandler->sync(this);
     alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 47, _ctx);
     while (alt != 2 && alt != atn::ATN::INVALID_ALT_NUMBER) {
@@ -4393,15 +4410,15 @@ GIScriptParser::AndContext* GIScriptParser::and_(int precedence) {
         previousContext = _localctx;
         _localctx = _tracker.createInstance<AndContext>(parentContext, parentState);
         pushNewRecursionContext(_localctx, startState, RuleAnd);
-        setState(461);
+        setState(463);
 
         if (!(precpred(_ctx, 2))) throw FailedPredicateException(this, "precpred(_ctx, 2)");
-        setState(462);
+        setState(464);
         match(GIScriptParser::T__59);
-        setState(463);
+        setState(465);
         equality(0); 
       }
-      setState(468);
+      setState(470);
       _errHandler->sync(this);
       alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 47, _ctx);
     }
@@ -4479,10 +4496,10 @@ GIScriptParser::XorContext* GIScriptParser::xor_(int precedence) {
   try {
     size_t alt;
     enterOuterAlt(_localctx, 1);
-    setState(470);
+    setState(472);
     and_(0);
     _ctx->stop = _input->LT(-1);
-    setState(477);
+    setState(479);
     _errHandler->sync(this);
     alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 48, _ctx);
     while (alt != 2 && alt != atn::ATN::INVALID_ALT_NUMBER) {
@@ -4492,15 +4509,15 @@ GIScriptParser::XorContext* GIScriptParser::xor_(int precedence) {
         previousContext = _localctx;
         _localctx = _tracker.createInstance<XorContext>(parentContext, parentState);
         pushNewRecursionContext(_localctx, startState, RuleXor);
-        setState(472);
+        setState(474);
 
         if (!(precpred(_ctx, 2))) throw FailedPredicateException(this, "precpred(_ctx, 2)");
-        setState(473);
+        setState(475);
         match(GIScriptParser::T__60);
-        setState(474);
+        setState(476);
         and_(0); 
       }
-      setState(479);
+      setState(481);
       _errHandler->sync(this);
       alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 48, _ctx);
     }
@@ -4578,10 +4595,10 @@ GIScriptParser::OrContext* GIScriptParser::or_(int precedence) {
   try {
     size_t alt;
     enterOuterAlt(_localctx, 1);
-    setState(481);
+    setState(483);
     xor_(0);
     _ctx->stop = _input->LT(-1);
-    setState(488);
+    setState(490);
     _errHandler->sync(this);
     alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 49, _ctx);
     while (alt != 2 && alt != atn::ATN::INVALID_ALT_NUMBER) {
@@ -4591,15 +4608,15 @@ GIScriptParser::OrContext* GIScriptParser::or_(int precedence) {
         previousContext = _localctx;
         _localctx = _tracker.createInstance<OrContext>(parentContext, parentState);
         pushNewRecursionContext(_localctx, startState, RuleOr);
-        setState(483);
+        setState(485);
 
         if (!(precpred(_ctx, 2))) throw FailedPredicateException(this, "precpred(_ctx, 2)");
-        setState(484);
+        setState(486);
         match(GIScriptParser::T__61);
-        setState(485);
+        setState(487);
         xor_(0); 
       }
-      setState(490);
+      setState(492);
       _errHandler->sync(this);
       alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 49, _ctx);
     }
@@ -4677,10 +4694,10 @@ GIScriptParser::LogicalAndContext* GIScriptParser::logicalAnd(int precedence) {
   try {
     size_t alt;
     enterOuterAlt(_localctx, 1);
-    setState(492);
+    setState(494);
     or_(0);
     _ctx->stop = _input->LT(-1);
-    setState(499);
+    setState(501);
     _errHandler->sync(this);
     alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 50, _ctx);
     while (alt != 2 && alt != atn::ATN::INVALID_ALT_NUMBER) {
@@ -4690,15 +4707,15 @@ GIScriptParser::LogicalAndContext* GIScriptParser::logicalAnd(int precedence) {
         previousContext = _localctx;
         _localctx = _tracker.createInstance<LogicalAndContext>(parentContext, parentState);
         pushNewRecursionContext(_localctx, startState, RuleLogicalAnd);
-        setState(494);
+        setState(496);
 
         if (!(precpred(_ctx, 2))) throw FailedPredicateException(this, "precpred(_ctx, 2)");
-        setState(495);
+        setState(497);
         match(GIScriptParser::T__62);
-        setState(496);
+        setState(498);
         or_(0); 
       }
-      setState(501);
+      setState(503);
       _errHandler->sync(this);
       alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 50, _ctx);
     }
@@ -4776,10 +4793,10 @@ GIScriptParser::LogicalOrContext* GIScriptParser::logicalOr(int precedence) {
   try {
     size_t alt;
     enterOuterAlt(_localctx, 1);
-    setState(503);
+    setState(505);
     logicalAnd(0);
     _ctx->stop = _input->LT(-1);
-    setState(510);
+    setState(512);
     _errHandler->sync(this);
     alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 51, _ctx);
     while (alt != 2 && alt != atn::ATN::INVALID_ALT_NUMBER) {
@@ -4789,15 +4806,15 @@ GIScriptParser::LogicalOrContext* GIScriptParser::logicalOr(int precedence) {
         previousContext = _localctx;
         _localctx = _tracker.createInstance<LogicalOrContext>(parentContext, parentState);
         pushNewRecursionContext(_localctx, startState, RuleLogicalOr);
-        setState(505);
+        setState(507);
 
         if (!(precpred(_ctx, 2))) throw FailedPredicateException(this, "precpred(_ctx, 2)");
-        setState(506);
+        setState(508);
         match(GIScriptParser::T__63);
-        setState(507);
+        setState(509);
         logicalAnd(0); 
       }
-      setState(512);
+      setState(514);
       _errHandler->sync(this);
       alt = getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 51, _ctx);
     }
@@ -4867,20 +4884,20 @@ GIScriptParser::ConditionalContext* GIScriptParser::conditional() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(513);
+    setState(515);
     logicalOr(0);
-    setState(519);
+    setState(521);
     _errHandler->sync(this);
 
     _la = _input->LA(1);
     if (_la == GIScriptParser::T__64) {
-      setState(514);
+      setState(516);
       match(GIScriptParser::T__64);
-      setState(515);
+      setState(517);
       expr();
-      setState(516);
+      setState(518);
       match(GIScriptParser::T__31);
-      setState(517);
+      setState(519);
       conditional();
     }
    
@@ -4950,21 +4967,21 @@ GIScriptParser::AssignmentContext* GIScriptParser::assignment() {
     exitRule();
   });
   try {
-    setState(526);
+    setState(528);
     _errHandler->sync(this);
     switch (getInterpreter<atn::ParserATNSimulator>()->adaptivePredict(_input, 53, _ctx)) {
     case 1: {
       enterOuterAlt(_localctx, 1);
-      setState(521);
+      setState(523);
       conditional();
       break;
     }
 
     case 2: {
       enterOuterAlt(_localctx, 2);
-      setState(522);
+      setState(524);
       unary();
-      setState(523);
+      setState(525);
       antlrcpp::downCast<AssignmentContext *>(_localctx)->op = _input->LT(1);
       _la = _input->LA(1);
       if (!(((((_la - 25) & ~ 0x3fULL) == 0) &&
@@ -4975,7 +4992,7 @@ GIScriptParser::AssignmentContext* GIScriptParser::assignment() {
         _errHandler->reportMatch(this);
         consume();
       }
-      setState(524);
+      setState(526);
       initializer();
       break;
     }
@@ -5047,17 +5064,17 @@ GIScriptParser::ExprContext* GIScriptParser::expr() {
   });
   try {
     enterOuterAlt(_localctx, 1);
-    setState(528);
+    setState(530);
     assignment();
-    setState(533);
+    setState(535);
     _errHandler->sync(this);
     _la = _input->LA(1);
     while (_la == GIScriptParser::T__5) {
-      setState(529);
+      setState(531);
       match(GIScriptParser::T__5);
-      setState(530);
+      setState(532);
       assignment();
-      setState(535);
+      setState(537);
       _errHandler->sync(this);
       _la = _input->LA(1);
     }
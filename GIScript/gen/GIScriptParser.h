@@ -114,6 +114,8 @@ public:
     EventContext* event(size_t i);
     std::vector<FunctionContext *> function();
     FunctionContext* function(size_t i);
+    std::vector<VarDefContext *> varDef();
+    VarDefContext* varDef(size_t i);
 
     virtual void enterRule(antlr4::tree::ParseTreeListener *listener) override;
     virtual void exitRule(antlr4::tree::ParseTreeListener *listener) override;
@@ -164,6 +166,7 @@ public:
     virtual size_t getRuleIndex() const override;
     FunctionSignContext *functionSign();
     BlockContext *block();
+    antlr4::tree::TerminalNode *ID();
 
     virtual void enterRule(antlr4::tree::ParseTreeListener *listener) override;
     virtual void exitRule(antlr4::tree::ParseTreeListener *listener) override;
@@ -0,0 +1,192 @@
+module;
+#ifdef __APPLE__
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+module memory_usage;
+
+using namespace Ugc;
+
+struct Memory::Phase
+{
+	std::string name;
+	std::string module;
+	std::atomic<std::uint64_t> allocations = 0;
+	std::atomic<std::uint64_t> bytes = 0;
+	std::atomic<std::int64_t> peak = 0;
+};
+
+static std::atomic<bool> enabled = false;
+static std::atomic<std::int64_t> live = 0;
+static std::atomic<std::int64_t> peak = 0;
+static std::atomic<std::uint64_t> allocations = 0;
+static std::atomic<std::uint64_t> bytes = 0;
+static std::mutex phases_mutex;
+static std::vector<std::unique_ptr<Memory::Phase>> phases;
+static std::map<std::pair<std::string, std::string>, Memory::Phase*> phase_index;
+static thread_local Memory::Phase* current = nullptr;
+
+// backed by malloc, so the bookkeeping of a recording does not feed back into operator new
+template<typename T>
+struct RawAllocator
+{
+	using value_type = T;
+
+	RawAllocator() = default;
+	template<typename U> RawAllocator(const RawAllocator<U>&) {}
+
+	T* allocate(std::size_t n)
+	{
+		if (auto p = std::malloc(n * sizeof(T))) return (T*)p;
+		throw std::bad_alloc();
+	}
+
+	void deallocate(T* p, std::size_t) { std::free(p); }
+
+	bool operator==(const RawAllocator&) const = default;
+};
+
+// the blocks allocated while recording with their sizes, so freeing a block from before the start leaves the live count alone
+static std::mutex blocks_mutex;
+static std::unordered_map<void*, std::size_t, std::hash<void*>, std::equal_to<void*>, RawAllocator<std::pair<void* const, std::size_t>>> blocks;
+
+// what the allocator reserved for the block, the bytes it keeps live until its free
+static std::size_t BlockSize(void* block)
+{
+#ifdef _WIN32
+	return _msize(block);
+#elif defined(__APPLE__)
+	return malloc_size(block);
+#else
+	return malloc_usable_size(block);
+#endif
+}
+
+static void Raise(std::atomic<std::int64_t>& mark, std::int64_t value)
+{
+	for (auto old = mark.load(std::memory_order_relaxed); value > old && !mark.compare_exchange_weak(old, value, std::memory_order_relaxed);)
+	{
+	}
+}
+
+bool Memory::Enabled()
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void Memory::Start()
+{
+	enabled = false;
+	{
+		std::lock_guard lock(phases_mutex);
+		phase_index.clear();
+		phases.clear();
+	}
+	{
+		std::lock_guard lock(blocks_mutex);
+		blocks.clear();
+	}
+	live = 0;
+	peak = 0;
+	allocations = 0;
+	bytes = 0;
+	enabled = true;
+}
+
+void Memory::Stop()
+{
+	enabled = false;
+	std::lock_guard lock(blocks_mutex);
+	blocks.clear();
+}
+
+void Memory::Allocated(void* block)
+{
+	if (!enabled.load(std::memory_order_relaxed)) return;
+	auto size = BlockSize(block);
+	{
+		std::lock_guard lock(blocks_mutex);
+		blocks.insert_or_assign(block, size);
+	}
+	auto now = live.fetch_add((std::int64_t)size, std::memory_order_relaxed) + (std::int64_t)size;
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	bytes.fetch_add(size, std::memory_order_relaxed);
+	Raise(peak, now);
+	if (auto phase = current)
+	{
+		phase->allocations.fetch_add(1, std::memory_order_relaxed);
+		phase->bytes.fetch_add(size, std::memory_order_relaxed);
+		Raise(phase->peak, now);
+	}
+}
+
+void Memory::Freed(void* block)
+{
+	if (!block || !enabled.load(std::memory_order_relaxed)) return;
+	std::size_t size;
+	{
+		std::lock_guard lock(blocks_mutex);
+		auto it = blocks.find(block);
+		if (it == blocks.end()) return;
+		size = it->second;
+		blocks.erase(it);
+	}
+	live.fetch_sub((std::int64_t)size, std::memory_order_relaxed);
+}
+
+std::int64_t Memory::Live()
+{
+	return live;
+}
+
+std::int64_t Memory::Peak()
+{
+	return peak;
+}
+
+Memory::Usage Memory::Total()
+{
+	return { "total", "", allocations, bytes, peak };
+}
+
+std::vector<Memory::Usage> Memory::Report()
+{
+	std::lock_guard lock(phases_mutex);
+	std::vector<Usage> report;
+	for (auto& p : phases) report.emplace_back(p->name, p->module, p->allocations, p->bytes, p->peak);
+	return report;
+}
+
+// one tab separated record per line: "phase <name> <module> <allocations> <bytes> <peak>", the module empty outside any,
+// then "total <allocations> <bytes> <peak>" over everything allocated while recording
+void Memory::Save(const std::filesystem::path& path)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) throw std::runtime_error(std::format("Cannot write memory report '{}'", path.string()));
+	for (auto& u : Report()) file << std::format("phase\t{}\t{}\t{}\t{}\t{}\n", u.phase, u.module, u.allocations, u.bytes, u.peak);
+	auto total = Total();
+	file << std::format("total\t{}\t{}\t{}\n", total.allocations, total.bytes, total.peak);
+	if (!file.flush()) throw std::runtime_error(std::format("Cannot write memory report '{}'", path.string()));
+}
+
+Memory::Phase* Memory::Enter(const char* phase, std::string_view module)
+{
+	auto previous = current;
+	std::pair<std::string, std::string> key(phase, module.empty() && previous ? std::string_view(previous->module) : module);
+	std::lock_guard lock(phases_mutex);
+	auto& entry = phase_index[key];
+	if (!entry)
+	{
+		entry = phases.emplace_back(std::make_unique<Phase>()).get();
+		entry->name = std::move(key.first);
+		entry->module = std::move(key.second);
+	}
+	current = entry;
+	return previous;
+}
+
+void Memory::Leave(Phase* previous)
+{
+	current = previous;
+}
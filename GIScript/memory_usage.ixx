@@ -0,0 +1,65 @@
+module;
+#ifdef _MSC_VER
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+export module memory_usage;
+
+import std;
+
+// allocation counts, bytes and live high-water marks per compile phase and module, fed by the replacement operator new in allocator.cpp;
+// while no recording runs an allocation costs a call and a relaxed load, while one runs every block is also looked up under a lock
+export namespace Ugc::Memory
+{
+	struct Phase;
+
+	struct Usage
+	{
+		std::string phase;
+		std::string module;
+		std::uint64_t allocations;
+		std::uint64_t bytes;
+		// the most bytes live at any allocation made in the phase
+		std::int64_t peak;
+	};
+
+	EXPORT bool Enabled();
+	// starts a fresh recording; must not be called while a Scope is open
+	EXPORT void Start();
+	EXPORT void Stop();
+	EXPORT void Allocated(void* block);
+	EXPORT void Freed(void* block);
+	// bytes allocated and not yet freed since the recording started, and the most that were
+	EXPORT std::int64_t Live();
+	EXPORT std::int64_t Peak();
+	EXPORT Usage Total();
+	// one entry per phase and module, in the order they were first entered
+	EXPORT std::vector<Usage> Report();
+	EXPORT void Save(const std::filesystem::path& path);
+	EXPORT Phase* Enter(const char* phase, std::string_view module);
+	EXPORT void Leave(Phase* previous);
+
+	// attributes the allocations of this thread to phase; an empty module keeps the one of the enclosing scope
+	class Scope
+	{
+		Phase* previous = nullptr;
+		bool active = false;
+
+	public:
+		explicit Scope(const char* phase, std::string_view module = {})
+		{
+			if (!Enabled()) return;
+			previous = Enter(phase, module);
+			active = true;
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+		~Scope()
+		{
+			if (active) Leave(previous);
+		}
+	};
+}
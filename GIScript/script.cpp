@@ -82,6 +82,16 @@ static std::string MakeString(const std::string& text)
 	return std::regex_replace(str, r2, "\n");
 }
 
+std::any Parser::visitProgram(GIScriptParser::ProgramContext* context)
+{
+	for (auto c : context->children)
+	{
+		if (auto v = dynamic_cast<GIScriptParser::VarDefContext*>(c)) declarations.emplace_back(std::make_unique<GraphVarDef>(std::move(*std::unique_ptr<VarDef>((VarDef*)std::any_cast<StatementNode*>(visitVarDef(v))))));
+		else if (!dynamic_cast<antlr4::tree::TerminalNode*>(c)) visit(c);
+	}
+	return {};
+}
+
 std::any Parser::visitEvent(GIScriptParser::EventContext* context)
 {
 	std::vector<Variable> parameters;
@@ -100,6 +110,13 @@ std::any Parser::visitFunction(GIScriptParser::FunctionContext* context)
 {
 	std::vector<Variable> parameters;
 	std::optional<VarType> ret;
+	auto hint = FunctionNode::Auto;
+	if (auto h = context->ID())
+	{
+		if (h->getText() == "inline") hint = FunctionNode::Inline;
+		else if (h->getText() == "noinline") hint = FunctionNode::NoInline;
+		else throw std::runtime_error(std::format("Unknown function specifier '{}'", h->getText()));
+	}
 	if (context->functionSign()->type()) ret = MakeType(context->functionSign()->type());
 	if (context->functionSign()->parameterList())
 	{
@@ -109,7 +126,7 @@ std::any Parser::visitFunction(GIScriptParser::FunctionContext* context)
 		}
 	}
 	if (context->children[0]->getText() == "global") global_functions.emplace_back(std::make_unique<FunctionNode>(context->functionSign()->ID()->getText(), std::move(ret), std::move(parameters), std::move(*std::unique_ptr<BlockNode>((BlockNode*)std::any_cast<StatementNode*>(visitBlock(context->block()))))));
-	else declarations.emplace_back(std::make_unique<FunctionNode>(context->functionSign()->ID()->getText(), std::move(ret), std::move(parameters), std::move(*std::unique_ptr<BlockNode>((BlockNode*)std::any_cast<StatementNode*>(visitBlock(context->block()))))));
+	else declarations.emplace_back(std::make_unique<FunctionNode>(context->functionSign()->ID()->getText(), std::move(ret), std::move(parameters), std::move(*std::unique_ptr<BlockNode>((BlockNode*)std::any_cast<StatementNode*>(visitBlock(context->block())))), hint));
 	return {};
 }
 
@@ -56,6 +56,7 @@ export namespace GI::Script
 		std::any visitInitializerList(GIScriptParser::InitializerListContext* context) override;
 	public:
 		Parser();
+		std::any visitProgram(GIScriptParser::ProgramContext* context) override;
 		std::unique_ptr<Ugc::Script::ASTNode> Release();
 	};
 }
@@ -0,0 +1,117 @@
+module trace;
+
+using namespace Ugc;
+
+struct TraceEvent
+{
+	const char* name;
+	std::string detail;
+	std::int64_t start;
+	std::int64_t end;
+};
+
+// one buffer per thread, so recording never contends with other threads
+struct TraceBuffer
+{
+	std::mutex mutex;
+	std::uint32_t thread;
+	std::vector<TraceEvent> events;
+};
+
+static std::atomic<bool> enabled = false;
+static std::atomic<std::int64_t> epoch = 0;
+static std::mutex buffers_mutex;
+static std::vector<std::shared_ptr<TraceBuffer>> buffers;
+static std::uint32_t threads = 0;
+
+static TraceBuffer& LocalBuffer()
+{
+	thread_local std::shared_ptr<TraceBuffer> buffer = []
+		{
+			std::lock_guard lock(buffers_mutex);
+			auto b = std::make_shared<TraceBuffer>();
+			b->thread = ++threads;
+			buffers.push_back(b);
+			return b;
+		}();
+	return *buffer;
+}
+
+static std::int64_t Clock()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static std::string Escape(std::string_view text)
+{
+	std::string escaped;
+	for (unsigned char c : text)
+	{
+		if (c == '"' || c == '\\') escaped += '\\';
+		if (c < 0x20) escaped += std::format("\\u{:04x}", c);
+		else escaped += (char)c;
+	}
+	return escaped;
+}
+
+bool Trace::Enabled()
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void Trace::Start()
+{
+	{
+		std::lock_guard lock(buffers_mutex);
+		// buffers only the registry still holds belong to threads that have exited
+		std::erase_if(buffers, [](const std::shared_ptr<TraceBuffer>& b) { return b.use_count() == 1; });
+		for (auto& b : buffers)
+		{
+			std::lock_guard l(b->mutex);
+			b->events.clear();
+		}
+	}
+	epoch = Clock();
+	enabled = true;
+}
+
+void Trace::Stop()
+{
+	enabled = false;
+}
+
+std::int64_t Trace::Now()
+{
+	return Clock() - epoch.load(std::memory_order_relaxed);
+}
+
+void Trace::Record(const char* name, std::string detail, std::int64_t start, std::int64_t end)
+{
+	auto& buffer = LocalBuffer();
+	std::lock_guard lock(buffer.mutex);
+	buffer.events.emplace_back(name, std::move(detail), start, end);
+}
+
+// complete ("X") events, one thread row per recording thread
+void Trace::Save(const std::filesystem::path& path)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) throw std::runtime_error(std::format("Cannot write trace '{}'", path.string()));
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	auto first = true;
+	std::lock_guard lock(buffers_mutex);
+	for (auto& b : buffers)
+	{
+		std::lock_guard l(b->mutex);
+		for (auto& e : b->events)
+		{
+			file << (first ? "\n" : ",\n");
+			first = false;
+			file << std::format("{{\"name\":\"{}\",\"cat\":\"gis\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{},\"dur\":{}", Escape(e.name), b->thread, e.start, e.end - e.start);
+			if (!e.detail.empty()) file << std::format(",\"args\":{{\"detail\":\"{}\"}}", Escape(e.detail));
+			file << "}";
+		}
+	}
+	file << "\n]}\n";
+	if (!file.flush()) throw std::runtime_error(std::format("Cannot write trace '{}'", path.string()));
+}
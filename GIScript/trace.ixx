@@ -0,0 +1,48 @@
+module;
+#ifdef _MSC_VER
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+export module trace;
+
+import std;
+
+// scoped timing spans for the parser and the compiler, written as Chrome trace events (chrome://tracing, Perfetto);
+// while no recording runs a span costs a call and a relaxed load
+export namespace Ugc::Trace
+{
+	EXPORT bool Enabled();
+	// starts a fresh recording, dropping the spans of an earlier one
+	EXPORT void Start();
+	EXPORT void Stop();
+	// microseconds since the recording started
+	EXPORT std::int64_t Now();
+	EXPORT void Record(const char* name, std::string detail, std::int64_t start, std::int64_t end);
+	EXPORT void Save(const std::filesystem::path& path);
+
+	class Span
+	{
+		const char* name = nullptr;
+		std::string detail;
+		std::int64_t start = 0;
+
+	public:
+		// name must outlive the recording, detail is copied and only when recording
+		explicit Span(const char* name, std::string_view detail = {})
+		{
+			if (!Enabled()) return;
+			this->name = name;
+			this->detail = detail;
+			start = Now();
+		}
+
+		Span(const Span&) = delete;
+		Span& operator=(const Span&) = delete;
+
+		~Span()
+		{
+			if (name) Record(name, std::move(detail), start, Now());
+		}
+	};
+}
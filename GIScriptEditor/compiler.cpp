@@ -2,6 +2,9 @@ module;
 #include <GINodeGraph.h>
 module compiler;
 
+import trace;
+import memory_usage;
+
 using namespace Editor::Tools;
 
 struct EventParameter
@@ -191,6 +194,7 @@ public:
 
 	const EventProto& Lookup(const std::string& name, const std::vector<Variable>& parameters)
 	{
+		Trace::Span span("RegistryLookup", name);
 		auto it = registries.find(name);
 		if (it == registries.end()) throw std::runtime_error("Unknown event: " + name);
 		auto& overloads = it->second;
@@ -259,6 +263,43 @@ struct FunctionProto
 	}
 };
 
+static unsigned DictionaryTypeIndex(const Script::VarType& type)
+{
+	switch (type.type)
+	{
+	case Script::VarType::Entity: return 0;
+	case Script::VarType::Int: return 2;
+	case Script::VarType::Bool: return 3;
+	case Script::VarType::Float: return 4;
+	case Script::VarType::String: return 5;
+	case Script::VarType::Vec: return 7;
+	case Script::VarType::Guid:
+		switch (std::any_cast<GuidEx>(type.extra))
+		{
+		case GuidEx::Entity: return 1;
+		case GuidEx::Faction: return 6;
+		case GuidEx::Configuration: return 8;
+		case GuidEx::Prefab: return 9;
+		}
+	default: throw std::runtime_error("Unsupported dictionary type");
+	}
+}
+
+// Dictionary node families are laid out per key type in blocks of value types.
+// List-valued variants either follow the scalar block (stride 20) or live in a separate range (stride 10).
+static NodeId DictionaryNode(NodeId scalar, std::optional<NodeId> list, const Script::VarType& type)
+{
+	auto& [key, value] = std::any_cast<const MapEx&>(type.extra);
+	static constexpr unsigned keys[]{ 0, 1, 2, ~0u, ~0u, 3, 4, ~0u, 5, 6 };
+	auto k = keys[DictionaryTypeIndex(key)];
+	if (k == ~0u) throw std::runtime_error("Unsupported dictionary key type");
+	auto stride = list.has_value() && std::to_underlying(*list) == std::to_underlying(scalar) + 10 ? 20 : 10;
+	if (value.type != Script::VarType::List) return static_cast<NodeId>(std::to_underlying(scalar) + k * stride + DictionaryTypeIndex(value));
+	auto element = DictionaryTypeIndex(std::any_cast<const Script::VarType&>(value.extra));
+	if (!list.has_value() || element == 9) throw std::runtime_error("Unsupported dictionary value type");
+	return static_cast<NodeId>(std::to_underlying(*list) + k * stride + element);
+}
+
 static class FunctionRegistry
 {
 	std::unordered_map<std::string, std::list<FunctionProto>> registries;
@@ -280,6 +321,7 @@ static class FunctionRegistry
 	static Script::VarType Faction() { return { Script::VarType::Guid, GuidEx::Faction }; }
 	static Script::VarType List(Script::VarType element) { return { Script::VarType::List, element }; }
 	static Script::VarType Map(MapEx ex) { return { Script::VarType::Map, ex }; }
+	static Script::VarType Tuple(std::vector<Script::VarType> types) { return { Script::VarType::Tuple, std::move(types) }; }
 public:
 	class Ref
 	{
@@ -302,6 +344,7 @@ public:
 		Register("GetSelfEntity", { Entity() }, {}, GetSelfEntity, true);
 		Register("QueryEntitybyGUID", { Entity() }, { Guid() }, QueryEntitybyGUID, true);
 		Register("QueryGUIDbyEntity", { Guid() }, { Entity() }, QueryGUIDbyEntity, true);
+		Register("GetEntityLocationandRotation", { Tuple({ Vec(),Vec() }) }, { Entity() }, GetEntityLocationandRotation, true);
 		Register("SettleStage", {}, { Bool() }, SettleStage);
 		Register("StartTimer", {}, { Entity(),String(),Bool(),List(Float()) }, StartTimer);
 		Register("PauseTimer", {}, { Entity(),String() }, PauseTimer);
@@ -632,6 +675,159 @@ public:
 			Register("Clear", {}, { List(Prefab()) }, ClearListPrefab, false, generic);
 			Register("Clear", {}, { List(Faction()) }, ClearListFaction, false, generic);
 		}
+		{
+			auto generic = std::make_shared<GenericPins>();
+			auto& [in_pins, out_pins] = *generic;
+			in_pins[0] =
+			{
+				{ List(Int()), 0 },
+				{ List(String()), 1 },
+				{ List(Entity()), 2 },
+				{ List(Guid()), 3 },
+				{ List(Float()), 4 },
+				{ List(Vec()), 5 },
+				{ List(Bool()), 6 },
+				{ List(Cfg()), 7 },
+				{ List(Prefab()), 8 },
+				{ List(Faction()), 9 }
+			};
+			in_pins[1] = in_pins[0];
+
+			Register("ConcatenateList", {}, { List(Int()),List(Int()) }, ConcatenateListInt, false, generic);
+			Register("ConcatenateList", {}, { List(String()),List(String()) }, ConcatenateListStr, false, generic);
+			Register("ConcatenateList", {}, { List(Entity()),List(Entity()) }, ConcatenateListEntity, false, generic);
+			Register("ConcatenateList", {}, { List(Guid()),List(Guid()) }, ConcatenateListGUID, false, generic);
+			Register("ConcatenateList", {}, { List(Float()),List(Float()) }, ConcatenateListFloat, false, generic);
+			Register("ConcatenateList", {}, { List(Vec()),List(Vec()) }, ConcatenateListVec, false, generic);
+			Register("ConcatenateList", {}, { List(Bool()),List(Bool()) }, ConcatenateListBool, false, generic);
+			Register("ConcatenateList", {}, { List(Cfg()),List(Cfg()) }, ConcatenateListConfig, false, generic);
+			Register("ConcatenateList", {}, { List(Prefab()),List(Prefab()) }, ConcatenateListPrefab, false, generic);
+			Register("ConcatenateList", {}, { List(Faction()),List(Faction()) }, ConcatenateListFaction, false, generic);
+
+			Register("GetListLength", { Int() }, { List(Int()) }, GetListLengthInt, true, generic);
+			Register("GetListLength", { Int() }, { List(String()) }, GetListLengthStr, true, generic);
+			Register("GetListLength", { Int() }, { List(Entity()) }, GetListLengthEntity, true, generic);
+			Register("GetListLength", { Int() }, { List(Guid()) }, GetListLengthGUID, true, generic);
+			Register("GetListLength", { Int() }, { List(Float()) }, GetListLengthFloat, true, generic);
+			Register("GetListLength", { Int() }, { List(Vec()) }, GetListLengthVec, true, generic);
+			Register("GetListLength", { Int() }, { List(Bool()) }, GetListLengthBool, true, generic);
+			Register("GetListLength", { Int() }, { List(Cfg()) }, GetListLengthConfig, true, generic);
+			Register("GetListLength", { Int() }, { List(Prefab()) }, GetListLengthPrefab, true, generic);
+			Register("GetListLength", { Int() }, { List(Faction()) }, GetListLengthFaction, true, generic);
+		}
+		{
+			auto generic = std::make_shared<GenericPins>();
+			auto& [in_pins, out_pins] = *generic;
+			in_pins[0] =
+			{
+				{ List(Int()), 0 },
+				{ List(String()), 1 },
+				{ List(Entity()), 2 },
+				{ List(Guid()), 3 },
+				{ List(Float()), 4 },
+				{ List(Vec()), 5 },
+				{ List(Bool()), 6 },
+				{ List(Cfg()), 7 },
+				{ List(Prefab()), 8 },
+				{ List(Faction()), 9 }
+			};
+			in_pins[1] =
+			{
+				{ Int(), 0 },
+				{ String(), 1 },
+				{ Entity(), 2 },
+				{ Guid(), 3 },
+				{ Float(), 4 },
+				{ Vec(), 5 },
+				{ Bool(), 6 },
+				{ Cfg(), 7 },
+				{ Prefab(), 8 },
+				{ Faction(), 9 }
+			};
+
+			Register("ListIncludesThisValue", { Bool() }, { List(Int()),Int() }, ListIncludesThisValueInt, true, generic);
+			Register("ListIncludesThisValue", { Bool() }, { List(String()),String() }, ListIncludesThisValueStr, true, generic);
+			Register("ListIncludesThisValue", { Bool() }, { List(Entity()),Entity() }, ListIncludesThisValueEntity, true, generic);
+			Register("ListIncludesThisValue", { Bool() }, { List(Guid()),Guid() }, ListIncludesThisValueGUID, true, generic);
+			Register("ListIncludesThisValue", { Bool() }, { List(Float()),Float() }, ListIncludesThisValueFloat, true, generic);
+			Register("ListIncludesThisValue", { Bool() }, { List(Vec()),Vec() }, ListIncludesThisValueVec, true, generic);
+			Register("ListIncludesThisValue", { Bool() }, { List(Bool()),Bool() }, ListIncludesThisValueBool, true, generic);
+			Register("ListIncludesThisValue", { Bool() }, { List(Cfg()),Cfg() }, ListIncludesThisValueConfig, true, generic);
+			Register("ListIncludesThisValue", { Bool() }, { List(Prefab()),Prefab() }, ListIncludesThisValuePrefab, true, generic);
+			Register("ListIncludesThisValue", { Bool() }, { List(Faction()),Faction() }, ListIncludesThisValueFaction, true, generic);
+
+			Register("SearchListandReturnValueID", { List(Int()) }, { List(Int()),Int() }, SearchListandReturnValueIDInt, true, generic);
+			Register("SearchListandReturnValueID", { List(Int()) }, { List(String()),String() }, SearchListandReturnValueIDStr, true, generic);
+			Register("SearchListandReturnValueID", { List(Int()) }, { List(Entity()),Entity() }, SearchListandReturnValueIDEntity, true, generic);
+			Register("SearchListandReturnValueID", { List(Int()) }, { List(Guid()),Guid() }, SearchListandReturnValueIDGUID, true, generic);
+			Register("SearchListandReturnValueID", { List(Int()) }, { List(Float()),Float() }, SearchListandReturnValueIDFloat, true, generic);
+			Register("SearchListandReturnValueID", { List(Int()) }, { List(Vec()),Vec() }, SearchListandReturnValueIDVec, true, generic);
+			Register("SearchListandReturnValueID", { List(Int()) }, { List(Bool()),Bool() }, SearchListandReturnValueIDBool, true, generic);
+			Register("SearchListandReturnValueID", { List(Int()) }, { List(Cfg()),Cfg() }, SearchListandReturnValueIDConfig, true, generic);
+			Register("SearchListandReturnValueID", { List(Int()) }, { List(Prefab()),Prefab() }, SearchListandReturnValueIDPrefab, true, generic);
+			Register("SearchListandReturnValueID", { List(Int()) }, { List(Faction()),Faction() }, SearchListandReturnValueIDFaction, true, generic);
+		}
+		{
+			auto generic = std::make_shared<GenericPins>();
+			auto& [in_pins, out_pins] = *generic;
+			in_pins[0] =
+			{
+				{ List(Int()), 0 },
+				{ List(Float()), 1 }
+			};
+			out_pins[0] =
+			{
+				{ Int(), 0 },
+				{ Float(), 1 }
+			};
+
+			Register("GetMaximumValuefromList", { Int() }, { List(Int()) }, GetMaximumValuefromListInt, true, generic);
+			Register("GetMaximumValuefromList", { Float() }, { List(Float()) }, GetMaximumValuefromListFloat, true, generic);
+			Register("GetMinimumValueFromList", { Int() }, { List(Int()) }, GetMinimumValueFromListInt, true, generic);
+			Register("GetMinimumValueFromList", { Float() }, { List(Float()) }, GetMinimumValueFromListFloat, true, generic);
+		}
+		{
+			auto generic = std::make_shared<GenericPins>();
+			auto& [in_pins, out_pins] = *generic;
+			in_pins[0] =
+			{
+				{ Int(), 0 },
+				{ Float(), 1 }
+			};
+			in_pins[1] = in_pins[0];
+			in_pins[2] = in_pins[0];
+			out_pins[0] = in_pins[0];
+
+			Register("TakeLargerValue", { Int() }, { Int(),Int() }, TakeLargerValueInt, true, generic);
+			Register("TakeLargerValue", { Float() }, { Float(),Float() }, TakeLargerValueFloat, true, generic);
+			Register("TakeSmallerValue", { Int() }, { Int(),Int() }, TakeSmallerValueInt, true, generic);
+			Register("TakeSmallerValue", { Float() }, { Float(),Float() }, TakeSmallerValueFloat, true, generic);
+			Register("RangeLimitingOperation", { Int() }, { Int(),Int(),Int() }, RangeLimitingOperationInt, true, generic);
+			Register("RangeLimitingOperation", { Float() }, { Float(),Float(),Float() }, RangeLimitingOperationFloat, true, generic);
+			Register("AbsoluteValueOperation", { Int() }, { Int() }, AbsoluteValueOperationInt, true, generic);
+			Register("AbsoluteValueOperation", { Float() }, { Float() }, AbsoluteValueOperationFloat, true, generic);
+			Register("SignOperation", { Int() }, { Int() }, SignOperationInt, true, generic);
+			Register("SignOperation", { Float() }, { Float() }, SignOperationFloat, true, generic);
+		}
+		for (auto& key : { Entity(),Guid(),Int(),String(),Faction(),Cfg(),Prefab() })
+		{
+			for (auto& element : { Entity(),Guid(),Int(),Bool(),Float(),String(),Faction(),Vec(),Cfg(),Prefab() })
+			{
+				for (auto& value : { element,List(element) })
+				{
+					if (value == List(Prefab())) continue;
+					auto map = Map({ key,value });
+					Register("QueryIfDictionaryContainsSpecificKey", { Bool() }, { map,key }, DictionaryNode(QueryIfDictionaryContainsSpecificKeyEntityEntity, QueryIfDictionaryContainsSpecificKeyEntityListEntity, map), true);
+					Register("RemoveKeyValuePairsfromDictionarybyKey", {}, { map,key }, DictionaryNode(RemoveKeyValuePairsfromDictionarybyKeyEntityEntity, RemoveKeyValuePairsfromDictionarybyKeyEntityListEntity, map));
+					Register("GetListofKeysfromDictionary", { List(key) }, { map }, DictionaryNode(GetListofKeysfromDictionaryEntityEntity, GetListofKeysfromDictionaryEntityListEntity, map), true);
+					Register("QueryDictionarysLength", { Int() }, { map }, DictionaryNode(QueryDictionarysLengthEntityEntity, QueryDictionarysLengthEntityListEntity, map), true);
+					Register("ClearDictionary", {}, { map }, DictionaryNode(ClearDictionaryEntityEntity, ClearDictionaryEntityListEntity, map));
+					if (value.type == Script::VarType::List) continue;
+					Register("QueryIfDictionaryContainsSpecificValue", { Bool() }, { map,value }, DictionaryNode(QueryIfDictionaryContainsSpecificValueEntityEntity, {}, map), true);
+					Register("GetListofValuesfromDictionary", { List(value) }, { map }, DictionaryNode(GetListofValuesfromDictionaryEntityEntity, {}, map), true);
+				}
+			}
+		}
 	}
 
 	std::optional<Ref> Find(const std::string& name)
@@ -643,6 +839,7 @@ public:
 
 	static const FunctionProto& Lookup(const Ref& ref, const std::vector<Script::VarType>& args)
 	{
+		Trace::Span span("RegistryLookup", ref.it->first);
 		auto& overloads = ref.it->second;
 		for (auto& proto : overloads)
 		{
@@ -670,6 +867,16 @@ struct LValueContext
 		int pin1, pin2;
 	} custom;
 
+	struct
+	{
+		INode* dictionary;
+		int pin;
+		std::function<void(INode&)> key;
+		Script::VarType type;
+	} entry;
+
+	std::string variable;
+
 	std::unique_ptr<INode> CreateSetter(IGraph& graph, const Script::VarType& type) const;
 };
 
@@ -690,9 +897,41 @@ struct ExprContent
 	int pin{};
 	mutable bool branch = false;
 	mutable std::vector<unsigned> branches;
+	// evaluating it cannot fault, so it may run before a guard has been checked
+	bool safe = false;
 	std::variant<std::monostate, int64_t, float, std::string, bool> literal;
 	std::variant<std::monostate, LValueContext, FunctionRegistry::Ref, std::vector<std::shared_ptr<ExprContent>>, UserFunction> extra;
 
+	// a plain read or a literal, which can be read again without adding nodes
+	struct Leaf
+	{
+		Script::VarType type;
+		INode* node;
+		int pin;
+		std::variant<std::monostate, int64_t, float, std::string, bool> literal;
+
+		bool operator==(const Leaf& other) const
+		{
+			return type == other.type && literal == other.literal && (literal.index() != 0 || (node == other.node && pin == other.pin));
+		}
+	};
+
+	// how a comparison, negation or ternary over leaves was formed, so an enclosing ternary can match min/max/clamp/abs/sign
+	struct Shape
+	{
+		enum Kind
+		{
+			Compare,	// l, r
+			Negate,		// x
+			Smaller,	// x, bound
+			Larger,		// x, bound
+			Choice		// l, r, then, else of a ternary on l op r
+		} kind;
+		BinaryExpr::Op op;
+		std::vector<Leaf> operands;
+	};
+	std::optional<Shape> shape;
+
 	ExprContent() = default;
 
 	explicit ExprContent(decltype(literal) literal) : literal(std::move(literal))
@@ -708,6 +947,8 @@ struct ExprContent
 
 	explicit ExprContent(Script::VarType type) : retType(std::move(type)) {}
 
+	bool Safe() const { return safe || literal.index() != 0; }
+
 	void Add(IGraph& graph, const std::function<void(INode*)>& layout) const
 	{
 		for (auto& n : nodes)
@@ -1125,6 +1366,45 @@ struct NodeFactory
 		node->Set(0, index, true);
 	}
 
+	static std::unique_ptr<INode> NodeGraphDictionary(IGraph& graph, const Script::VarType& type, bool set)
+	{
+		if (set) return graph.CreateNode(DictionaryNode(SetNodeGraphVariableDictEntityEntity, SetNodeGraphVariableDictEntityListEntity, type));
+		return graph.CreateNode(DictionaryNode(GetNodeGraphVariableDictEntityEntity, GetNodeGraphVariableDictEntityListEntity, type));
+	}
+
+	static unsigned VariableIndex(const Script::VarType& type)
+	{
+		static constexpr unsigned scalars[]{ 0, 1, 2, 3, 4, 5, 6, 14, 15, 18 }, lists[]{ 7, 8, 9, 10, 11, 12, 13, 16, 17, 19 };
+		auto list = type.type == Script::VarType::List;
+		auto element = ListElementIndex(list ? std::any_cast<const Script::VarType&>(type.extra) : type);
+		if (!element.has_value()) throw std::runtime_error("Unsupported variable type");
+		return (list ? lists : scalars)[*element];
+	}
+
+	static std::unique_ptr<INode> NodeGraphVariable(IGraph& graph, const Script::VarType& type, bool set)
+	{
+		static constexpr NodeId getters[]
+		{
+			GetNodeGraphVariableInt, GetNodeGraphVariableStr, GetNodeGraphVariableEntity, GetNodeGraphVariableGUID, GetNodeGraphVariableFloat,
+			GetNodeGraphVariableVec, GetNodeGraphVariableBool, GetNodeGraphVariableListInt, GetNodeGraphVariableListStr, GetNodeGraphVariableListEntity,
+			GetNodeGraphVariableListGUID, GetNodeGraphVariableListFloat, GetNodeGraphVariableListVec, GetNodeGraphVariableListBool, GetNodeGraphVariableConfig,
+			GetNodeGraphVariablePrefab, GetNodeGraphVariableListConfig, GetNodeGraphVariableListPrefab, GetNodeGraphVariableFaction, GetNodeGraphVariableListFaction
+		};
+		static constexpr NodeId setters[]
+		{
+			SetNodeGraphVariableInt, SetNodeGraphVariableStr, SetNodeGraphVariableEntity, SetNodeGraphVariableGUID, SetNodeGraphVariableFloat,
+			SetNodeGraphVariableVec, SetNodeGraphVariableBool, SetNodeGraphVariableListInt, SetNodeGraphVariableListStr, SetNodeGraphVariableListEntity,
+			SetNodeGraphVariableListGUID, SetNodeGraphVariableListFloat, SetNodeGraphVariableListVec, SetNodeGraphVariableListBool, SetNodeGraphVariableConfig,
+			SetNodeGraphVariablePrefab, SetNodeGraphVariableListConfig, SetNodeGraphVariableListPrefab, SetNodeGraphVariableFaction, SetNodeGraphVariableListFaction
+		};
+		if (type.type == Script::VarType::Map) return NodeGraphDictionary(graph, type, set);
+		auto index = VariableIndex(type);
+		auto node = graph.CreateNode((set ? setters : getters)[index]);
+		if (set) node->Set(1, index, false);
+		else node->Set(0, index, true);
+		return node;
+	}
+
 	static std::unique_ptr<INode> GetCustomVariable(IGraph& graph, const Script::VarType& type)
 	{
 		auto node = graph.CreateNode(GetCustomVariableBool);
@@ -1707,6 +1987,28 @@ struct NodeFactory
 		return node;
 	}
 
+	static std::optional<unsigned> ListElementIndex(const Script::VarType& type)
+	{
+		switch (type.type)
+		{
+		case Script::VarType::Int: return 0;
+		case Script::VarType::String: return 1;
+		case Script::VarType::Entity: return 2;
+		case Script::VarType::Float: return 4;
+		case Script::VarType::Vec: return 5;
+		case Script::VarType::Bool: return 6;
+		case Script::VarType::Guid:
+			switch (std::any_cast<GuidEx>(type.extra))
+			{
+			case GuidEx::Entity: return 3;
+			case GuidEx::Configuration: return 7;
+			case GuidEx::Prefab: return 8;
+			case GuidEx::Faction: return 9;
+			}
+		default: return {};
+		}
+	}
+
 	static std::unique_ptr<INode> Cast(IGraph& graph, const ExprContent& expr, const Script::VarType& type)
 	{
 		switch (expr.retType.type)
@@ -1779,10 +2081,10 @@ struct NodeFactory
 			case GuidEx::Faction:
 				in = 6;
 				break;
-			default: throw std::exception("Unreached code");
+			default: throw std::runtime_error("Unreached code");
 			}
 			break;
-		default: throw std::exception("Unreached code");
+		default: throw std::runtime_error("Unreached code");
 		}
 		switch (type.type)
 		{
@@ -1798,7 +2100,7 @@ struct NodeFactory
 		case Script::VarType::String:
 			out = 2;
 			break;
-		default:throw std::exception("Unreached code");
+		default:throw std::runtime_error("Unreached code");
 		}
 		auto node = graph.CreateNode(DataTypeConversionIntBool);
 		node->Set(0, in, false);
@@ -1822,6 +2124,18 @@ struct VarContent
 	bool iterator;
 };
 
+struct GraphVariable
+{
+	std::string name;
+};
+
+struct BoundValue
+{
+	INode* node;
+	int pin;
+	decltype(ExprContent::literal) literal;
+};
+
 std::unique_ptr<INode> LValueContext::CreateSetter(IGraph& graph, const Script::VarType& type) const
 {
 	std::unique_ptr<INode> node;
@@ -1831,6 +2145,17 @@ std::unique_ptr<INode> LValueContext::CreateSetter(IGraph& graph, const Script::
 		auto& [content, iterator] = std::any_cast<VarContent&>(local->content);
 		std::get<0>(content)->Connect(*node, 0, 0);
 	}
+	else if (entry.dictionary)
+	{
+		node = graph.CreateNode(DictionaryNode(NodeId::SetorAddKeyValuePairstoDictionaryEntityEntity, NodeId::SetorAddKeyValuePairstoDictionaryEntityListEntity, entry.type));
+		entry.dictionary->Connect(*node, entry.pin, 0);
+		entry.key(*node);
+	}
+	else if (!variable.empty())
+	{
+		node = NodeFactory::NodeGraphVariable(graph, type, true);
+		node->Set(0, variable);
+	}
 	else
 	{
 		node = NodeFactory::SetCustomVariable(graph, type);
@@ -2017,122 +2342,658 @@ static void DefinePin(INode& node, const Script::VarType& type, int pin, bool ge
 	}
 }
 
-class NodeGenerator : public ASTVisitor
+struct Simplifier
 {
-	friend Compiler;
-	using enum NodeId;
-	IGraph& graph;
-	Compiler& compiler;
-	INode* prev = nullptr;
-	INode* entrypoint = nullptr;
-	INode* current_loop = nullptr;
-	std::optional<std::reference_wrapper<const EventProto>> proto;
-	float x = 0, y = 0;
-	unsigned flow = 0;
+	enum class Pattern
+	{
+		Any,
+		Zero,
+		One,
+		True,
+		False,
+		Same,
+		Reciprocable
+	};
 
-	struct
+	enum class Result
 	{
-		INode* ret;
-		std::optional<Script::VarType> type;
-		bool in_function;
-	} function_header{};
+		Left,
+		Right,
+		Cancel,
+		Reciprocal
+	};
 
-	struct
+	struct Rule
 	{
-		struct Arg
-		{
-			INode* node;
-			Script::VarType type;
-		};
+		std::string_view name;
+		BinaryExpr::Op op;
+		unsigned types;
+		Pattern left;
+		Pattern right;
+		Result result;
+		unsigned eliminated;
+	};
 
-		struct Declaration
-		{
-			std::vector<Arg> parameters;
-			std::optional<Arg> ret;
-			INode* entrypoint;
-		};
+	struct Involution
+	{
+		std::string_view name;
+		UnaryExpr::Op op;
+		unsigned types;
+	};
 
-		std::unordered_map<std::string, Declaration> map;
-	} function_storage;
-public:
-	explicit NodeGenerator(IGraph& graph, Compiler& compiler) : graph(graph), compiler(compiler)
+	static constexpr unsigned Of(std::initializer_list<Script::VarType::Type> types)
 	{
+		unsigned mask = 0;
+		for (auto t : types) mask |= 1u << t;
+		return mask;
 	}
 
-private:
-	void AutoLayout(INode* node)
+	using enum Script::VarType::Type;
+	using enum Pattern;
+	using enum Result;
+
+	static constexpr Rule rules[]
 	{
-		node->SetPos(x, y);
-		x += 500;
-		if (x > 2000)
+		{ "x + 0", BinaryExpr::Add, Of({ Int,Float }), Any, Zero, Left, 1 },
+		{ "0 + x", BinaryExpr::Add, Of({ Int,Float }), Zero, Any, Right, 1 },
+		{ "x - 0", BinaryExpr::Sub, Of({ Int,Float }), Any, Zero, Left, 1 },
+		{ "x - x", BinaryExpr::Sub, Of({ Int }), Any, Same, Cancel, 1 },
+		{ "x * 1", BinaryExpr::Mul, Of({ Int,Float,Vec }), Any, One, Left, 1 },
+		{ "1 * x", BinaryExpr::Mul, Of({ Int,Float }), One, Any, Right, 1 },
+		{ "x / 1", BinaryExpr::Div, Of({ Int,Float }), Any, One, Left, 1 },
+		{ "x / c", BinaryExpr::Div, Of({ Float }), Any, Reciprocable, Reciprocal, 0 },
+		{ "x << 0", BinaryExpr::ShL, Of({ Int }), Any, Zero, Left, 1 },
+		{ "x >> 0", BinaryExpr::ShR, Of({ Int }), Any, Zero, Left, 1 },
+		{ "x | 0", BinaryExpr::OR, Of({ Int }), Any, Zero, Left, 1 },
+		{ "0 | x", BinaryExpr::OR, Of({ Int }), Zero, Any, Right, 1 },
+		{ "x ^ 0", BinaryExpr::XOR, Of({ Int }), Any, Zero, Left, 1 },
+		{ "0 ^ x", BinaryExpr::XOR, Of({ Int }), Zero, Any, Right, 1 },
+		{ "b == true", BinaryExpr::EQ, Of({ Bool }), Any, True, Left, 1 },
+		{ "true == b", BinaryExpr::EQ, Of({ Bool }), True, Any, Right, 1 },
+		{ "b != false", BinaryExpr::NE, Of({ Bool }), Any, False, Left, 2 },
+		{ "false != b", BinaryExpr::NE, Of({ Bool }), False, Any, Right, 2 },
+		{ "b && true", BinaryExpr::LogAND, Of({ Bool }), Any, True, Left, 1 },
+		{ "true && b", BinaryExpr::LogAND, Of({ Bool }), True, Any, Right, 1 },
+		{ "b || false", BinaryExpr::LogOR, Of({ Bool }), Any, False, Left, 1 },
+		{ "false || b", BinaryExpr::LogOR, Of({ Bool }), False, Any, Right, 1 },
+		{ "b ^ false", BinaryExpr::XOR, Of({ Bool }), Any, False, Left, 1 },
+		{ "false ^ b", BinaryExpr::XOR, Of({ Bool }), False, Any, Right, 1 }
+	};
+
+	static constexpr Involution involutions[]
+	{
+		{ "!!b", UnaryExpr::LogicalNOT, Of({ Bool }) },
+		{ "--x", UnaryExpr::Negate, Of({ Int,Float }) },
+		{ "~~x", UnaryExpr::BitwiseNOT, Of({ Int }) }
+	};
+
+	static bool Droppable(const ExprContent& e)
+	{
+		return e.literal.index() != 0 || (e.nodes.empty() && !e.flowStart && !e.branch);
+	}
+
+	static bool Matches(Pattern pattern, const ExprContent& e, const ExprContent& other)
+	{
+		switch (pattern)
 		{
-			x = 0;
-			y += 600;
+		case Any:
+			return true;
+		case Zero:
+		case One:
+		{
+			auto v = pattern == One ? 1 : 0;
+			if (e.literal.index() == 1) return std::get<int64_t>(e.literal) == v;
+			if (e.literal.index() == 2) return std::get<float>(e.literal) == static_cast<float>(v);
+			return false;
 		}
+		case True:
+		case False:
+			return e.literal.index() == 4 && std::get<bool>(e.literal) == (pattern == True);
+		case Same:
+			return e.literal.index() == 0 && Droppable(e) && Droppable(other) && e.end && e.end == other.end && e.pin == other.pin;
+		case Reciprocable:
+		{
+			// only powers of two, where x * (1 / c) is bit-identical to x / c
+			if (e.literal.index() != 2) return false;
+			int exp;
+			auto mantissa = std::frexp(std::get<float>(e.literal), &exp);
+			return mantissa == 0.5f || mantissa == -0.5f;
+		}
+		}
+		return false;
 	}
 
-	static void SetLiteral(INode& node, int pin, const ExprContent& expr, const Script::VarType& type)
+	static const Rule* Find(BinaryExpr::Op op, const ExprContent& left, const ExprContent& right)
 	{
-		switch (expr.literal.index())
+		auto l = left.retType.type, r = right.retType.type;
+		if (l != r && !(op == BinaryExpr::Mul && l == Vec && r == Float)) return nullptr;
+		for (auto& rule : rules)
 		{
-		case 0: return;
-		case 1:
-		case 2:
-			switch (type.type)
-			{
-			case Script::VarType::Bool:
-				node.Fill(pin, Enum{ (unsigned)expr.Get<int64_t>() }, ServerVarType::Boolean);
-				return;
-			case Script::VarType::Guid:
-				switch (std::any_cast<GuidEx>(type.extra))
-				{
-				case GuidEx::Entity:
-					node.Fill(pin, GUID{ (unsigned)expr.Get<int64_t>() }, ServerVarType::GUID);
-					break;
-				case GuidEx::Prefab:
-					node.Fill(pin, GUID{ (unsigned)expr.Get<int64_t>() }, ServerVarType::Prefab);
-					break;
-				case GuidEx::Configuration:
-					node.Fill(pin, GUID{ (unsigned)expr.Get<int64_t>() }, ServerVarType::Configuration);
-					break;
-				case GuidEx::Faction:
-					node.Fill(pin, GUID{ (unsigned)expr.Get<int64_t>() }, ServerVarType::Faction);
-					break;
-				}
-				return;
-			case Script::VarType::Int:
-				node.Fill(pin, expr.Get<int64_t>());
-				return;
-			case Script::VarType::Float:
-				node.Fill(pin, expr.Get<float>());
-				return;
-			default: throw std::runtime_error("Type mismatch");
-			}
-		case 3:
-			node.Fill(pin, std::get<std::string>(expr.literal));
-			return;
+			if (rule.op != op || !(rule.types & 1u << l)) continue;
+			if (!Matches(rule.left, left, right) || !Matches(rule.right, right, left)) continue;
+			if ((rule.result == Left && !Droppable(right)) || (rule.result == Right && !Droppable(left))) continue;
+			return &rule;
 		}
-		throw std::runtime_error("Unreached code");
+		return nullptr;
 	}
 
-	static void SetLiteralNormal(INode& node, int pin, const ExprContent& expr, const Script::VarType& type)
+	static const Involution* Find(UnaryExpr::Op op, const ExprContent& value)
 	{
-		switch (expr.literal.index())
-		{
-		case 0: return;
-		case 1:
-		case 2:
-			switch (type.type)
-			{
-			case Script::VarType::Bool:
-				node.Set(pin, Enum{ (unsigned)expr.Get<int64_t>() }, ServerVarType::Boolean);
-				return;
-			case Script::VarType::Guid:
-				switch (std::any_cast<GuidEx>(type.extra))
-				{
-				case GuidEx::Entity:
-					node.Set(pin, GUID{ (unsigned)expr.Get<int64_t>() }, ServerVarType::GUID);
-					break;
+		for (auto& rule : involutions) if (rule.op == op && rule.types & 1u << value.retType.type) return &rule;
+		return nullptr;
+	}
+};
+
+struct NodeRef
+{
+	std::uint32_t buffer;
+	std::uint32_t slot;
+};
+
+struct CompositeRef
+{
+	std::string name;
+	IGraph* graph;
+};
+
+using StagedValue = std::variant<int, unsigned, unsigned long long, long long, float, double, bool, std::string, std::u8string, Vec, Enum, GUID, NodeGraph::VarType, NodeId, PinType, NodeRef, CompositeRef,
+	List<unsigned long long>, List<float>, List<std::string>, List<Vec>, List<GUID>>;
+
+// one recorded call on a staging graph or one of its nodes; plain data, so a module's lowering can be replayed later or stored on disk
+struct StagedOp
+{
+	enum Kind : std::uint8_t
+	{
+		Create,
+		CreateComposite,
+		AddNode,
+		AddCreated,
+		Destroy,
+		AddComment,
+		SetCompositePin,
+		SetCompositePinName,
+		Change,
+		Connect,
+		ConnectFlow,
+		Set,
+		SetTyped,
+		SetList,
+		SetListAt,
+		SetAt,
+		SetTypedAt,
+		SetType,
+		SetTypeAt,
+		Fill,
+		FillTyped,
+		FillList,
+		SetPos,
+		SetComment
+	};
+
+	Kind kind;
+	NodeRef node;
+	std::vector<StagedValue> args;
+
+	template<typename T>
+	const T& Arg(std::size_t i) const { return std::get<T>(args.at(i)); }
+};
+
+struct StagedBuffer
+{
+	std::vector<StagedOp> log;
+	float height;
+};
+
+// records graph construction on worker threads so it can be replayed into the real graph in a fixed order,
+// giving a module lowered declaration by declaration the same nodes, ids and layout as a sequential walk
+class StagingGraph final : public IGraph
+{
+	class Node final : public INode
+	{
+		friend StagingGraph;
+		StagingGraph* owner;
+		std::uint32_t slot;
+
+		void Record(StagedOp::Kind kind, std::vector<StagedValue> args)
+		{
+			if (!active) throw std::runtime_error("Staged node used outside of its task");
+			active->log.emplace_back(kind, NodeRef{ owner->index, slot }, std::move(args));
+		}
+
+		static NodeRef Ref(INode& node)
+		{
+			auto n = dynamic_cast<Node*>(&node);
+			if (!n) throw std::runtime_error("Cannot connect a staged node to a node outside the staging graph");
+			return { n->owner->index, n->slot };
+		}
+
+		template<typename T>
+		void RecordList(StagedOp::Kind kind, int pin, const void* ptr, int length, NodeGraph::VarType type, std::optional<unsigned> index)
+		{
+			std::vector<StagedValue> args{ pin, List<T>((const T*)ptr, (const T*)ptr + length), type };
+			if (index) args.emplace_back(*index);
+			Record(kind, std::move(args));
+		}
+
+		void RecordList(StagedOp::Kind kind, int pin, const void* ptr, int length, NodeGraph::VarType type, std::optional<unsigned> index = std::nullopt)
+		{
+			switch (std::holds_alternative<ServerVarType>(type) ? std::get<ServerVarType>(type) : ServerVarType::Unknown)
+			{
+			case ServerVarType::IntegerList: return RecordList<unsigned long long>(kind, pin, ptr, length, type, index);
+			case ServerVarType::FloatList: return RecordList<float>(kind, pin, ptr, length, type, index);
+			case ServerVarType::StringList: return RecordList<std::string>(kind, pin, ptr, length, type, index);
+			case ServerVarType::VectorList: return RecordList<Vec>(kind, pin, ptr, length, type, index);
+			default: return RecordList<GUID>(kind, pin, ptr, length, type, index);
+			}
+		}
+
+	public:
+		Node(StagingGraph* owner, std::uint32_t slot) : owner(owner), slot(slot) {}
+
+		~Node() override
+		{
+			if (active) active->log.emplace_back(StagedOp::Destroy, NodeRef{ owner->index, slot });
+		}
+
+		unsigned Id() const override { return slot + 1; }
+		void Change(NodeId id) override { Record(StagedOp::Change, { id }); }
+		void Connect(INode& target, int from, int to, bool flow) override { Record(StagedOp::Connect, { Ref(target), from, to, flow }); }
+		void Connect(INode& target) override { Record(StagedOp::ConnectFlow, { Ref(target) }); }
+		void Set(int pin, unsigned long long value) override { Record(StagedOp::Set, { pin, value }); }
+		void Set(int pin, float value) override { Record(StagedOp::Set, { pin, value }); }
+		void Set(int pin, const std::string& value) override { Record(StagedOp::Set, { pin, value }); }
+		void Set(int pin, const char8_t* value) override { Record(StagedOp::Set, { pin, std::u8string(value) }); }
+		void Set(int pin, int value) override { Record(StagedOp::Set, { pin, value }); }
+		void Set(int pin, unsigned value) override { Record(StagedOp::Set, { pin, value }); }
+		void Set(int pin, double value) override { Record(StagedOp::Set, { pin, value }); }
+		void Set(int pin, const Vec& value) override { Record(StagedOp::Set, { pin, value }); }
+		void Set(int pin, const Enum& value, NodeGraph::VarType type) override { Record(StagedOp::SetTyped, { pin, value, type }); }
+		void Set(int pin, const GUID& value, NodeGraph::VarType type) override { Record(StagedOp::SetTyped, { pin, value, type }); }
+		void Set(int pin, const void* ptr, int length, NodeGraph::VarType type) override { RecordList(StagedOp::SetList, pin, ptr, length, type); }
+		void Set(int pin, const void* ptr, int length, NodeGraph::VarType type, unsigned index) override { RecordList(StagedOp::SetListAt, pin, ptr, length, type, index); }
+		void Set(int pin, unsigned index, unsigned long long value) override { Record(StagedOp::SetAt, { pin, index, value }); }
+		void Set(int pin, unsigned index, float value) override { Record(StagedOp::SetAt, { pin, index, value }); }
+		void Set(int pin, unsigned index, const std::string& value) override { Record(StagedOp::SetAt, { pin, index, value }); }
+		void Set(int pin, unsigned index, const Vec& value) override { Record(StagedOp::SetAt, { pin, index, value }); }
+		void Set(int pin, unsigned index, const Enum& value, NodeGraph::VarType type) override { Record(StagedOp::SetTypedAt, { pin, index, value, type }); }
+		void Set(int pin, unsigned index, const GUID& value, NodeGraph::VarType type) override { Record(StagedOp::SetTypedAt, { pin, index, value, type }); }
+		void Set(int pin, unsigned index, int value) override { Record(StagedOp::SetAt, { pin, index, value }); }
+		void Set(int pin, unsigned index, unsigned value) override { Record(StagedOp::SetAt, { pin, index, value }); }
+		void Set(int pin, unsigned index, double value) override { Record(StagedOp::SetAt, { pin, index, value }); }
+		void Set(int pin, unsigned index, bool out) override { Record(StagedOp::SetAt, { pin, index, out }); }
+		void Set(int pin, NodeGraph::VarType type, bool out) override { Record(StagedOp::SetType, { pin, type, out }); }
+		void Set(int pin, NodeGraph::VarType type, unsigned index, bool out) override { Record(StagedOp::SetTypeAt, { pin, type, index, out }); }
+		void Fill(int pin, long long value) override { Record(StagedOp::Fill, { pin, value }); }
+		void Fill(int pin, float value) override { Record(StagedOp::Fill, { pin, value }); }
+		void Fill(int pin, const Enum& value, NodeGraph::VarType type) override { Record(StagedOp::FillTyped, { pin, value, type }); }
+		void Fill(int pin, const GUID& value, NodeGraph::VarType type) override { Record(StagedOp::FillTyped, { pin, value, type }); }
+		void Fill(int pin, const std::string& value) override { Record(StagedOp::Fill, { pin, value }); }
+		void Fill(int pin, const Vec& value) override { Record(StagedOp::Fill, { pin, value }); }
+		void Fill(int pin, const void* ptr, int length, NodeGraph::VarType type) override { RecordList(StagedOp::FillList, pin, ptr, length, type); }
+		void SetPos(float x, float y) override { Record(StagedOp::SetPos, { x, y }); }
+		void SetComment(const std::string& text) override { Record(StagedOp::SetComment, { text }); }
+	};
+
+	static thread_local StagingGraph* active;
+	std::uint32_t index;
+	std::uint32_t slots = 0;
+	std::vector<StagedOp> log;
+	std::vector<std::unique_ptr<INode>> owned;
+	std::unordered_map<unsigned, INode*> added;
+
+	INode& Own(std::unique_ptr<INode> node)
+	{
+		auto& n = *owned.emplace_back(std::move(node));
+		added.emplace(n.Id(), &n);
+		return n;
+	}
+
+public:
+	explicit StagingGraph(std::uint32_t index) : index(index) {}
+
+	struct Activation
+	{
+		StagingGraph* previous;
+		~Activation() { active = previous; }
+	};
+
+	// every node operation issued on this thread lands in this graph's log until the activation ends
+	[[nodiscard]] Activation Activate() { return { std::exchange(active, this) }; }
+
+	StagedBuffer Release(float height) { return { std::move(log), height }; }
+
+	INode& AddNode(NodeId id) override
+	{
+		auto slot = slots++;
+		log.emplace_back(StagedOp::AddNode, NodeRef{ index, slot }, std::vector<StagedValue>{ id });
+		return Own(std::make_unique<Node>(this, slot));
+	}
+
+	INode& AddNode(std::unique_ptr<INode> node) override
+	{
+		auto n = dynamic_cast<Node*>(node.get());
+		if (!n || n->owner != this || added.contains(n->Id())) throw std::runtime_error("Node does not belong to this graph");
+		log.emplace_back(StagedOp::AddCreated, NodeRef{ index, n->slot });
+		return Own(std::move(node));
+	}
+
+	void AddComment(const std::string& text, float x, float y) override
+	{
+		log.emplace_back(StagedOp::AddComment, NodeRef{ index, 0 }, std::vector<StagedValue>{ text, x, y });
+	}
+
+	std::unique_ptr<INode> CreateNode(NodeId id) override
+	{
+		auto slot = slots++;
+		log.emplace_back(StagedOp::Create, NodeRef{ index, slot }, std::vector<StagedValue>{ id });
+		return std::make_unique<Node>(this, slot);
+	}
+
+	std::unique_ptr<INode> CreateNode(IGraph& composite) override
+	{
+		auto slot = slots++;
+		log.emplace_back(StagedOp::CreateComposite, NodeRef{ index, slot }, std::vector<StagedValue>{ CompositeRef{ {}, &composite } });
+		return std::make_unique<Node>(this, slot);
+	}
+
+	INode* Find(unsigned id) override
+	{
+		auto it = added.find(id);
+		return it == added.end() ? nullptr : it->second;
+	}
+
+	void SetCompositePin(INode& node, PinType type, uint32_t index, uint32_t composite_pin) override
+	{
+		log.emplace_back(StagedOp::SetCompositePin, Node::Ref(node), std::vector<StagedValue>{ type, (unsigned)index, (unsigned)composite_pin });
+	}
+
+	void SetCompositePinName(PinType type, uint32_t index, const std::string& name) override
+	{
+		log.emplace_back(StagedOp::SetCompositePinName, NodeRef{ this->index, 0 }, std::vector<StagedValue>{ type, (unsigned)index, name });
+	}
+};
+
+thread_local StagingGraph* StagingGraph::active = nullptr;
+
+// executes staged buffers against a real graph; buffers are stacked vertically in the order they are replayed
+class Replayer
+{
+	IGraph& target;
+	std::vector<std::vector<std::unique_ptr<INode>>> created;
+	std::vector<std::vector<INode*>> real;
+	float offset = 0;
+
+	INode*& Real(NodeRef ref)
+	{
+		if (real.size() <= ref.buffer) real.resize(ref.buffer + 1);
+		auto& nodes = real[ref.buffer];
+		if (nodes.size() <= ref.slot) nodes.resize(ref.slot + 1);
+		return nodes[ref.slot];
+	}
+
+	std::unique_ptr<INode>& Created(NodeRef ref)
+	{
+		if (created.size() <= ref.buffer) created.resize(ref.buffer + 1);
+		auto& nodes = created[ref.buffer];
+		if (nodes.size() <= ref.slot) nodes.resize(ref.slot + 1);
+		return nodes[ref.slot];
+	}
+
+	INode& Node(NodeRef ref)
+	{
+		auto n = Real(ref);
+		if (!n) throw std::runtime_error("Staged node replayed before it was created");
+		return *n;
+	}
+
+	template<typename... T, typename F>
+	static void Dispatch(const StagedValue& value, F&& f)
+	{
+		std::visit([&]<typename V>(const V & v)
+		{
+			if constexpr ((std::is_same_v<V, T> || ...)) f(v);
+			else throw std::runtime_error("Unexpected staged value");
+		}, value);
+	}
+
+	void Apply(const StagedOp& op, float dy)
+	{
+		auto pin = [&] { return op.Arg<int>(0); };
+		switch (op.kind)
+		{
+		case StagedOp::Create:
+			Real(op.node) = (Created(op.node) = target.CreateNode(op.Arg<NodeId>(0))).get();
+			return;
+		case StagedOp::CreateComposite:
+			Real(op.node) = (Created(op.node) = target.CreateNode(*op.Arg<CompositeRef>(0).graph)).get();
+			return;
+		case StagedOp::AddNode:
+			Real(op.node) = &target.AddNode(op.Arg<NodeId>(0));
+			return;
+		case StagedOp::AddCreated:
+			Real(op.node) = &target.AddNode(std::move(Created(op.node)));
+			return;
+		case StagedOp::Destroy:
+			Created(op.node).reset();
+			return;
+		case StagedOp::AddComment:
+			target.AddComment(op.Arg<std::string>(0), op.Arg<float>(1), op.Arg<float>(2) + dy);
+			return;
+		case StagedOp::SetCompositePin:
+			target.SetCompositePin(Node(op.node), op.Arg<PinType>(0), op.Arg<unsigned>(1), op.Arg<unsigned>(2));
+			return;
+		case StagedOp::SetCompositePinName:
+			target.SetCompositePinName(op.Arg<PinType>(0), op.Arg<unsigned>(1), op.Arg<std::string>(2));
+			return;
+		case StagedOp::Change:
+			Node(op.node).Change(op.Arg<NodeId>(0));
+			return;
+		case StagedOp::Connect:
+			Node(op.node).Connect(Node(op.Arg<NodeRef>(0)), op.Arg<int>(1), op.Arg<int>(2), op.Arg<bool>(3));
+			return;
+		case StagedOp::ConnectFlow:
+			Node(op.node).Connect(Node(op.Arg<NodeRef>(0)));
+			return;
+		case StagedOp::Set:
+			Dispatch<unsigned long long, float, std::string, int, unsigned, double, Vec, std::u8string>(op.args.at(1), [&]<typename V>(const V & v)
+			{
+				if constexpr (std::is_same_v<V, std::u8string>) Node(op.node).Set(pin(), v.c_str());
+				else Node(op.node).Set(pin(), v);
+			});
+			return;
+		case StagedOp::SetTyped:
+			Dispatch<Enum, GUID>(op.args.at(1), [&](const auto& v) { Node(op.node).Set(pin(), v, op.Arg<NodeGraph::VarType>(2)); });
+			return;
+		case StagedOp::SetList:
+		case StagedOp::SetListAt:
+		case StagedOp::FillList:
+			Dispatch<List<unsigned long long>, List<float>, List<std::string>, List<Vec>, List<GUID>>(op.args.at(1), [&](const auto& v)
+				{
+					auto type = op.Arg<NodeGraph::VarType>(2);
+					if (op.kind == StagedOp::FillList) Node(op.node).Fill(pin(), v.data(), (int)v.size(), type);
+					else if (op.kind == StagedOp::SetListAt) Node(op.node).Set(pin(), v.data(), (int)v.size(), type, op.Arg<unsigned>(3));
+					else Node(op.node).Set(pin(), v.data(), (int)v.size(), type);
+				});
+			return;
+		case StagedOp::SetAt:
+			Dispatch<unsigned long long, float, std::string, Vec, int, unsigned, double, bool>(op.args.at(2), [&](const auto& v) { Node(op.node).Set(pin(), op.Arg<unsigned>(1), v); });
+			return;
+		case StagedOp::SetTypedAt:
+			Dispatch<Enum, GUID>(op.args.at(2), [&](const auto& v) { Node(op.node).Set(pin(), op.Arg<unsigned>(1), v, op.Arg<NodeGraph::VarType>(3)); });
+			return;
+		case StagedOp::SetType:
+			Node(op.node).Set(pin(), op.Arg<NodeGraph::VarType>(1), op.Arg<bool>(2));
+			return;
+		case StagedOp::SetTypeAt:
+			Node(op.node).Set(pin(), op.Arg<NodeGraph::VarType>(1), op.Arg<unsigned>(2), op.Arg<bool>(3));
+			return;
+		case StagedOp::Fill:
+			Dispatch<long long, float, std::string, Vec>(op.args.at(1), [&](const auto& v) { Node(op.node).Fill(pin(), v); });
+			return;
+		case StagedOp::FillTyped:
+			Dispatch<Enum, GUID>(op.args.at(1), [&](const auto& v) { Node(op.node).Fill(pin(), v, op.Arg<NodeGraph::VarType>(2)); });
+			return;
+		case StagedOp::SetPos:
+			Node(op.node).SetPos(op.Arg<float>(0), op.Arg<float>(1) + dy);
+			return;
+		case StagedOp::SetComment:
+			Node(op.node).SetComment(op.Arg<std::string>(0));
+			return;
+		}
+		throw std::runtime_error("Unknown staged operation");
+	}
+
+public:
+	explicit Replayer(IGraph& target) : target(target) {}
+
+	void Run(const StagedBuffer& buffer)
+	{
+		for (auto& op : buffer.log) Apply(op, offset);
+		offset += buffer.height + 800;
+	}
+};
+
+class ModuleStage;
+
+class NodeGenerator : public ASTVisitor
+{
+	friend Compiler;
+	friend ModuleStage;
+	using enum NodeId;
+	IGraph& graph;
+	Compiler& compiler;
+	INode* prev = nullptr;
+	INode* entrypoint = nullptr;
+	INode* current_loop = nullptr;
+	std::optional<std::reference_wrapper<const EventProto>> proto;
+	float x = 0, y = 0;
+	unsigned flow = 0;
+	std::map<std::tuple<INode*, int, NodeId>, INode*> decompositions;
+	std::unordered_map<std::string, INode*> graph_variables;
+	std::map<std::tuple<INode*, int, std::string, unsigned>, unsigned> loads;
+	std::unordered_map<std::string, FunctionNode*> inline_functions;
+	// functions whose bodies are being expanded, innermost last; a call back into one of them stays a real call
+	std::vector<const FunctionNode*> inlining;
+	std::set<std::string> called;
+	std::size_t simplified = 0;
+	static constexpr std::size_t EAGER_COST_LIMIT = 4;
+	static constexpr std::size_t INLINE_COST_LIMIT = 4;
+
+	struct
+	{
+		INode* ret;
+		std::optional<Script::VarType> type;
+		bool in_function;
+	} function_header{};
+
+	struct
+	{
+		struct Arg
+		{
+			INode* node;
+			Script::VarType type;
+		};
+
+		struct Declaration
+		{
+			std::vector<Arg> parameters;
+			std::optional<Arg> ret;
+			INode* entrypoint;
+		};
+
+		std::unordered_map<std::string, Declaration> map;
+	} function_storage;
+public:
+	explicit NodeGenerator(IGraph& graph, Compiler& compiler) : graph(graph), compiler(compiler)
+	{
+	}
+
+private:
+	void AutoLayout(INode* node)
+	{
+		node->SetPos(x, y);
+		x += 500;
+		if (x > 2000)
+		{
+			x = 0;
+			y += 600;
+		}
+	}
+
+	// runs the flow of an already added expression on the current pin; a branched expression has no single exit,
+	// so its joins hang off the same pin and whatever follows runs once the taken arm is done
+	void Chain(const ExprContent& expr)
+	{
+		if (!expr.flowStart) return;
+		prev->Connect(*expr.flowStart, flow, 0, true);
+		for (auto id : expr.branches) if (auto n = graph.Find(id)) prev->Connect(*n, flow, 0, true);
+		if (!expr.flowEnd) return;
+		prev = expr.flowEnd;
+		flow = 0;
+	}
+
+	static void SetLiteral(INode& node, int pin, const ExprContent& expr, const Script::VarType& type)
+	{
+		switch (expr.literal.index())
+		{
+		case 0: return;
+		case 1:
+		case 2:
+			switch (type.type)
+			{
+			case Script::VarType::Bool:
+				node.Fill(pin, Enum{ (unsigned)expr.Get<int64_t>() }, ServerVarType::Boolean);
+				return;
+			case Script::VarType::Guid:
+				switch (std::any_cast<GuidEx>(type.extra))
+				{
+				case GuidEx::Entity:
+					node.Fill(pin, GUID{ (unsigned)expr.Get<int64_t>() }, ServerVarType::GUID);
+					break;
+				case GuidEx::Prefab:
+					node.Fill(pin, GUID{ (unsigned)expr.Get<int64_t>() }, ServerVarType::Prefab);
+					break;
+				case GuidEx::Configuration:
+					node.Fill(pin, GUID{ (unsigned)expr.Get<int64_t>() }, ServerVarType::Configuration);
+					break;
+				case GuidEx::Faction:
+					node.Fill(pin, GUID{ (unsigned)expr.Get<int64_t>() }, ServerVarType::Faction);
+					break;
+				}
+				return;
+			case Script::VarType::Int:
+				node.Fill(pin, expr.Get<int64_t>());
+				return;
+			case Script::VarType::Float:
+				node.Fill(pin, expr.Get<float>());
+				return;
+			default: throw std::runtime_error("Type mismatch");
+			}
+		case 3:
+			node.Fill(pin, std::get<std::string>(expr.literal));
+			return;
+		}
+		throw std::runtime_error("Unreached code");
+	}
+
+	static void SetLiteralNormal(INode& node, int pin, const ExprContent& expr, const Script::VarType& type)
+	{
+		switch (expr.literal.index())
+		{
+		case 0: return;
+		case 1:
+		case 2:
+			switch (type.type)
+			{
+			case Script::VarType::Bool:
+				node.Set(pin, Enum{ (unsigned)expr.Get<int64_t>() }, ServerVarType::Boolean);
+				return;
+			case Script::VarType::Guid:
+				switch (std::any_cast<GuidEx>(type.extra))
+				{
+				case GuidEx::Entity:
+					node.Set(pin, GUID{ (unsigned)expr.Get<int64_t>() }, ServerVarType::GUID);
+					break;
 				case GuidEx::Prefab:
 					node.Set(pin, GUID{ (unsigned)expr.Get<int64_t>() }, ServerVarType::Prefab);
 					break;
@@ -2161,14 +3022,35 @@ private:
 
 	auto layout() { return [this](INode* n) { AutoLayout(n); }; }
 
-	void VisitEvent(const std::string& event, const std::vector<Variable>& parameters) override
+	INode* Decompose(const ExprContent& value, NodeId id)
 	{
-		const EventProto& ep = *(proto = EventRegistry.Lookup(event, parameters));
-		if (prev) { x = 0; y += 800; }
+		auto& n = decompositions[{ value.end, value.pin, id }];
+		if (!n)
+		{
+			n = &graph.AddNode(id);
+			AutoLayout(n);
+			value.end->Connect(*n, value.pin, 0);
+		}
+		return n;
+	}
+
+	void Invalidate(const INode* source)
+	{
+		std::erase_if(decompositions, [source](const auto& d) { return std::get<0>(d.first) == source; });
+		std::erase_if(loads, [source](const auto& l) { return std::get<0>(l.first) == source; });
+	}
+
+	void VisitEvent(const std::string& event, const std::vector<Variable>& parameters) override
+	{
+		const EventProto& ep = *(proto = EventRegistry.Lookup(event, parameters));
+		if (prev) { x = 0; y += 800; }
 		prev = &ep.Create(graph);
 		entrypoint = prev;
 		AutoLayout(prev);
 		flow = 0;
+		decompositions.clear();
+		graph_variables.clear();
+		loads.clear();
 		for (auto& a : parameters)
 		{
 			unsigned pin = 0;
@@ -2184,11 +3066,14 @@ private:
 
 	void VisitFunction(const std::string& name, std::optional<Script::VarType> ret, const std::vector<Variable>& parameters) override
 	{
-		if (function_storage.map.contains(name) || compiler.GlobalFunctions.map.contains(name)) throw std::runtime_error(std::format("function '{}' is already defined", name));
+		if (function_storage.map.contains(name) || inline_functions.contains(name) || compiler.GlobalFunctions.map.contains(name)) throw std::runtime_error(std::format("function '{}' is already defined", name));
 		function_header.in_function = true;
 		if (prev) { x = 0; y += 800; }
 		graph.AddComment(std::format("function {}", name), x - 400, y);
 		flow = 0;
+		decompositions.clear();
+		graph_variables.clear();
+		loads.clear();
 		auto& [dp, dr, de] = function_storage.map[name];
 		for (auto& p : parameters)
 		{
@@ -2212,19 +3097,41 @@ private:
 		AutoLayout(prev);
 	}
 
-	void VisitGlobalFunction(const std::string& name, std::optional<Script::VarType> ret, const std::vector<Variable>& parameters)
+	bool VisitInlineFunction(FunctionNode& function) override
 	{
+		auto cost = function.InlineCost();
+		if (!cost.has_value() || function.InlineHint() == FunctionNode::NoInline) return false;
+		if (function.InlineHint() == FunctionNode::Auto && *cost > INLINE_COST_LIMIT) return false;
+		auto name = function.Name();
+		if (function_storage.map.contains(name) || inline_functions.contains(name) || compiler.GlobalFunctions.map.contains(name)) throw std::runtime_error(std::format("function '{}' is already defined", name));
+		inline_functions[name] = &function;
+		return true;
+	}
+
+	void VisitGlobalFunction(const FunctionNode& function)
+	{
+		auto name = function.Name();
+		auto ret = function.Ret();
 		if (compiler.GlobalFunctions.map.contains(name)) throw std::runtime_error(std::format("function '{}' is already defined", name));
 		function_header.in_function = true;
 		if (prev) { x = 0; y += 800; }
 		auto& [dp, dr, gr] = compiler.GlobalFunctions.map[name];
 		uint32_t pin = 0;
-		for (auto& p : parameters)
+		for (auto& p : function.Parameters())
 		{
 			auto n = &graph.AddNode(NodeFactory::GetLocalVariable(graph, p.Type()));
 			AutoLayout(n);
 			scope.add(p.Id(), std::make_unique<LocalVar>(p.Type(), VarContent{ n }));
 			n->SetComment(p.Id());
+			if (!function.Writes(p.Id()) && p.Type().type != Script::VarType::List)
+			{
+				// read-only parameters take the composite input as their initial value instead of being copied on entry
+				DefinePin(*n, p.Type(), 0, true, false);
+				graph.SetCompositePin(*n, PinType::Input, 0, pin);
+				graph.SetCompositePinName(PinType::Input, pin++, p.Id());
+				dp.emplace_back(p.Type());
+				continue;
+			}
 			auto& sn = graph.AddNode(NodeFactory::SetLocalVariable(graph, p.Type()));
 			AutoLayout(&sn);
 			n->Connect(sn, 0, 0);
@@ -2236,13 +3143,16 @@ private:
 			prev = &sn;
 			dp.emplace_back(p.Type());
 		}
-		if (ret.has_value())
+		if (ret.has_value() && !function.TailReturn())
 		{
 			auto n = function_header.ret = &graph.AddNode(NodeFactory::GetLocalVariable(graph, *ret));
 			AutoLayout(n);
 			n->SetComment("return");
 			DefinePin(*n, *ret, 1, true, true);
 			graph.SetCompositePin(*n, PinType::Output, 1, 0);
+		}
+		if (ret.has_value())
+		{
 			dr = *ret;
 			function_header.type = std::move(ret);
 		}
@@ -2257,18 +3167,122 @@ private:
 		gr = &graph;
 	}
 
+	void EndGlobalFunction()
+	{
+		scope.exit();
+		auto ex = prev;
+		if (flow != 0)
+		{
+			ex = &graph.AddNode(DoubleBranch);
+			ex->Set(0, Enum{ 1 }, ServerVarType::Boolean);
+			ex->SetComment("Dummy ExitPoint");
+			AutoLayout(ex);
+		}
+		std::lock_guard lock(compiler.composite_pins);
+		graph.SetCompositePin(*ex, PinType::Outflow, 0, 0);
+	}
+
+	std::unique_ptr<INode> CreateComposite(IGraph& composite)
+	{
+		std::lock_guard lock(compiler.composite_pins);
+		return graph.CreateNode(composite);
+	}
+
+	bool VisitOutlined(OutlinedStatement& statement) override
+	{
+		auto& name = statement.Name();
+		if (compiler.rejected_outlines.contains(name)) return false;
+		for (auto& c : statement.Callees()) if (!FunctionRegistry.Find(c).has_value() && !compiler.GlobalFunctions.map.contains(c)) return false;
+		for (auto& d : statement.Declared()) if (scope.contains(d) || function_storage.map.contains(d) || inline_functions.contains(d)) return false;
+		auto& arguments = statement.Arguments();
+		std::vector<std::unique_ptr<ExprContent>> args;
+		std::vector<Script::VarType> types;
+		for (std::size_t i = 0; i < arguments.size(); i++)
+		{
+			auto& e = args.emplace_back(std::any_cast<ExprContent*>(VisitIdentifier(arguments[i])));
+			switch (e->retType.type)
+			{
+			case Script::VarType::Unknown:
+			// parameters are copies, so a list the run changes in place would keep its old contents at the call site
+			case Script::VarType::List:
+			case Script::VarType::Map:
+			case Script::VarType::Tuple:
+			case Script::VarType::Function:
+				return false;
+			default:
+				break;
+			}
+			if (statement.MemberWritten(i) && e->retType.type != Script::VarType::Entity) return false;
+			types.push_back(e->retType);
+		}
+		if (auto it = compiler.GlobalFunctions.map.find(name); it != compiler.GlobalFunctions.map.end())
+		{
+			if (it->second.parameters != types) return false;
+		}
+		else if (!compiler.Outline(statement, types)) return false;
+		auto callee = std::make_unique<ExprContent>(Script::VarType{ Script::VarType::Function });
+		callee->extra = UserFunction{ name, true };
+		std::vector<std::any> list;
+		for (auto& a : args) list.emplace_back(a.release());
+		VisitExprStatement(VisitCall(callee.release(), list, std::nullopt));
+		++compiler.outlined;
+		return true;
+	}
+
 	Script::VarType TypeInference(const std::any& value) override
 	{
 		if (!value.has_value()) throw std::runtime_error("Variables defined by 'var' must be initialized");
 		return std::any_cast<ExprContent*>(value)->retType;
 	}
 
+	std::unique_ptr<ExprContent> AssembleDictionary(const Script::VarType& type, const std::vector<std::shared_ptr<ExprContent>>& il)
+	{
+		auto& [key, value] = std::any_cast<const MapEx&>(type.extra);
+		auto expr = std::make_unique<ExprContent>(type);
+		ExprBuilder builder(*expr);
+		auto as = builder.Add(graph.CreateNode(DictionaryNode(AssemblyDictionaryEntityEntity, AssemblyDictionaryEntityListEntity, type)));
+		as->Set(0, (uint64_t)il.size());
+		int pin = 1;
+		for (auto& pair : il)
+		{
+			if (pair->extra.index() != 3 || std::get<3>(pair->extra).size() != 2) throw std::runtime_error("Dictionary initializer item must be a {key, value} pair");
+			auto& kv = std::get<3>(pair->extra);
+			for (int i = 0; i < 2; i++, pin++)
+			{
+				auto& item = *kv[i];
+				auto& t = i == 0 ? key : value;
+				if (item.literal.index() != 0)
+				{
+					SetLiteralNormal(*as, pin, item, t);
+					continue;
+				}
+				if (item.retType != t) throw std::runtime_error("Type mismatch with initializer list item");
+				expr->start = as;
+				builder.Combine(item, pin);
+			}
+		}
+		expr->start = as;
+		return expr;
+	}
+
+	void VisitGraphVarDef(const std::string& id, Script::VarType type) override
+	{
+		if (KEYWORDS.contains(id)) throw std::runtime_error(std::format("Cannot use keyword '{}' as identifier here", id));
+		if (type.type == Script::VarType::Unknown) throw std::runtime_error("Unknown variable type");
+		if (FunctionRegistry.Find(id).has_value() || function_storage.map.contains(id) || inline_functions.contains(id)) throw std::runtime_error(std::format("Identifier '{}' is already defined by a function", id));
+		if (scope.contains(id)) throw std::runtime_error(std::format("Variable '{}' is already defined in current scope", id));
+		if (type.type != Script::VarType::Map) NodeFactory::VariableIndex(type);
+		scope.add(id, std::make_unique<LocalVar>(type, GraphVariable{ id }));
+	}
+
 	void VisitVarDef(const std::string& id, Script::VarType type, const std::any& value) override
 	{
 		if (KEYWORDS.contains(id)) throw std::runtime_error(std::format("Cannot use keyword '{}' as identifier here", id));
 		if (type.type == Script::VarType::Unknown) throw std::runtime_error("Unknown variable type");
-		if (FunctionRegistry.Find(id).has_value() || function_storage.map.contains(id)) throw std::runtime_error(std::format("Identifier '{}' is already defined by a function", id));
+		if (FunctionRegistry.Find(id).has_value() || function_storage.map.contains(id) || inline_functions.contains(id)) throw std::runtime_error(std::format("Identifier '{}' is already defined by a function", id));
 		if (scope.contains(id)) throw std::runtime_error(std::format("Variable '{}' is already defined in current scope", id));
+		// dictionaries have no local variable node, and a graph variable standing in for one would be shared by every handler
+		if (type.type == Script::VarType::Map) throw std::runtime_error(std::format("Map variable '{}' must be declared at module scope, there are no local dictionaries", id));
 		auto n = &graph.AddNode(NodeFactory::GetLocalVariable(graph, type));
 		AutoLayout(n);
 		scope.add(id, std::make_unique<LocalVar>(type, VarContent{ n }));
@@ -2311,12 +3325,7 @@ private:
 								if (v->literal.index() == 0)
 								{
 									v->Add(graph, layout());
-									if (v->flowStart)
-									{
-										prev->Connect(*v->flowStart, flow, 0, true);
-										prev = v->flowEnd;
-										flow = 0;
-									}
+									Chain(*v);
 									v->end->Connect(cr, v->pin, i);
 								}
 								else cr.Set(i, v->Get<float>());
@@ -2347,12 +3356,7 @@ private:
 						if (i->literal.index() == 0)
 						{
 							i->Add(graph, layout());
-							if (i->flowStart)
-							{
-								prev->Connect(*i->flowStart, flow, 0, true);
-								prev = i->flowEnd;
-								flow = 0;
-							}
+							Chain(*i);
 							i->end->Connect(as, i->pin, pin);
 						}
 						else
@@ -2383,8 +3387,6 @@ private:
 					flow = 0;
 					break;
 				}
-				case Script::VarType::Map:
-					throw std::runtime_error("Cannot use map type for local variable");
 				default: throw std::runtime_error("Cannot use initializer list for this type");
 				}
 				return;
@@ -2394,12 +3396,7 @@ private:
 				auto& n2 = graph.AddNode(NodeFactory::SetLocalVariable(graph, type));
 				expr->Add(graph, layout());
 				AutoLayout(&n2);
-				if (expr->flowStart)
-				{
-					prev->Connect(*expr->flowStart, flow, 0, true);
-					prev = expr->flowEnd;
-					flow = 0;
-				}
+				Chain(*expr);
 				prev->Connect(n2, flow, 0, true);
 				n->Connect(n2, 0, 0);
 				expr->end->Connect(n2, expr->pin, 1);
@@ -2416,11 +3413,7 @@ private:
 		if (auto expr = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(value)); expr->flowStart)
 		{
 			expr->Add(graph, layout());
-			prev->Connect(*expr->flowStart, flow, 0, true);
-			for (auto br : expr->branches) if (auto n = graph.Find(br)) prev->Connect(*n);
-			if (!expr->flowEnd) throw std::exception("Unknown error");
-			prev = expr->flowEnd;
-			flow = 0;
+			Chain(*expr);
 		}
 	}
 
@@ -2444,12 +3437,7 @@ private:
 			ctx.branch = &br;
 			ctx.merge = prev;
 			value = ctx;
-			if (expr->flowStart)
-			{
-				prev->Connect(*expr->flowStart, flow, 0, true);
-				prev = expr->flowEnd;
-				flow = 0;
-			}
+			Chain(*expr);
 			prev->Connect(br, flow, 0, true);
 			if (expr->end) expr->end->Connect(br, expr->pin, 0);
 			else br.Set(0, Enum{ (unsigned)std::get<int64_t>(expr->literal) }, ServerVarType::Boolean);
@@ -2524,12 +3512,7 @@ private:
 		ctx.index = 0;
 		ctx.type = expr->retType.type;
 		value = ctx;
-		if (expr->flowStart)
-		{
-			prev->Connect(*expr->flowStart, flow, 0, true);
-			prev = expr->flowEnd;
-			flow = 0;
-		}
+		Chain(*expr);
 		prev->Connect(br, flow, 0, true);
 		if (expr->end) expr->end->Connect(br, expr->pin, 0);
 		else switch (expr->retType.type)
@@ -2540,7 +3523,7 @@ private:
 		case Script::VarType::String:
 			br.Set(0, 1, std::get<std::string>(expr->literal));
 			break;
-		default: throw std::exception("Unreached code");
+		default: throw std::runtime_error("Unreached code");
 		}
 		prev = &br;
 	}
@@ -2562,7 +3545,7 @@ private:
 			case Script::VarType::String:
 				ctx.values.emplace_back(std::get<std::string>(expr->literal));
 				break;
-			default: throw std::exception("Unreached code");
+			default: throw std::runtime_error("Unreached code");
 			}
 		}
 		else
@@ -2604,7 +3587,10 @@ private:
 		auto& br = graph.AddNode(DoubleBranch);
 		expr->Add(graph, layout());
 		AutoLayout(&br);
-		loop.Connect(br);
+		prev = &loop;
+		flow = 0;
+		Chain(*expr);
+		prev->Connect(br, flow, 0, true);
 		if (expr->end) expr->end->Connect(br, expr->pin, 0);
 		else br.Set(0, Enum{ (unsigned)std::get<int64_t>(expr->literal) }, ServerVarType::Boolean);
 		value = LoopContext{ &loop,&br,current_loop };
@@ -2642,12 +3628,10 @@ private:
 			auto& br = graph.AddNode(DoubleBranch);
 			expr->Add(graph, layout());
 			AutoLayout(&br);
-			if (expr->flowStart)
-			{
-				loop.Connect(*expr->flowStart);
-				expr->flowEnd->Connect(br);
-			}
-			else loop.Connect(br);
+			prev = &loop;
+			flow = 0;
+			Chain(*expr);
+			prev->Connect(br, flow, 0, true);
 			if (expr->end) expr->end->Connect(br, expr->pin, 0);
 			else br.Set(0, Enum{ (unsigned)std::get<int64_t>(expr->literal) }, ServerVarType::Boolean);
 			value = LoopContext{ &loop,&br,current_loop };
@@ -2662,21 +3646,231 @@ private:
 		flow = 0;
 	}
 
+	struct CountedLoopContext
+	{
+		INode* loop;
+		INode* merge;
+		unsigned flow;
+		INode* old;
+	};
+
+	// FiniteLoop gets [begin, end] inclusive; its behaviour for an empty range is not specified, so unless both
+	// bounds are literals the loop hangs off a begin < end (begin <= end) branch, which also keeps end - 1 from overflowing
+	// a graph variable in the bound may change under a call in the body, so only locals are read once
+	bool VisitCountedBound(const std::unordered_set<std::string>& exposed) override
+	{
+		for (auto& id : exposed)
+		{
+			auto var = scope.find(id);
+			if (!var || var->content.type() == typeid(GraphVariable)) return false;
+		}
+		return true;
+	}
+
+	void VisitCountedForStart(const std::string& var, const std::any& begin, const std::any& end, bool inclusive, std::any& value) override
+	{
+		auto first = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(begin));
+		auto last = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(end));
+		if (first->retType.type != Script::VarType::Int || last->retType.type != Script::VarType::Int) throw std::runtime_error("Loop bounds must be int");
+		for (auto bound : { first.get(), last.get() })
+		{
+			if (bound->literal.index() != 0) continue;
+			bound->Add(graph, layout());
+			Chain(*bound);
+		}
+		auto constant = first->literal.index() != 0 && last->literal.index() != 0;
+		auto empty = constant && (inclusive ? first->Get<int64_t>() > last->Get<int64_t>() : first->Get<int64_t>() >= last->Get<int64_t>());
+		CountedLoopContext ctx{ nullptr, prev, flow, current_loop };
+		if (!constant || empty)
+		{
+			auto& guard = graph.AddNode(DoubleBranch);
+			AutoLayout(&guard);
+			prev->Connect(guard, flow, 0, true);
+			if (empty) guard.Set(0, Enum{ 0 }, ServerVarType::Boolean);
+			else
+			{
+				auto& compare = graph.AddNode(NodeFactory::Compare(graph, *first, *last, inclusive ? BinaryExpr::LE : BinaryExpr::LT));
+				AutoLayout(&compare);
+				if (first->end) first->end->Connect(compare, first->pin, 0);
+				if (last->end) last->end->Connect(compare, last->pin, 1);
+				compare.Connect(guard, 0, 0);
+			}
+			prev = &guard;
+			flow = 0;
+		}
+		if (!inclusive && !empty)
+		{
+			if (last->literal.index() != 0)
+			{
+				// a dynamic begin is never below the minimum, so the guard already rules that bound out
+				if (auto v = last->Get<int64_t>(); v != std::numeric_limits<int64_t>::min()) last = std::make_unique<ExprContent>(v - 1);
+			}
+			else
+			{
+				auto& sub = graph.AddNode(NodeFactory::Sub(graph, *last, ExprContent(1)));
+				AutoLayout(&sub);
+				last->end->Connect(sub, last->pin, 0);
+				last->end = &sub;
+				last->pin = 0;
+			}
+		}
+		auto& loop = graph.AddNode(FiniteLoop);
+		AutoLayout(&loop);
+		unsigned pin = 0;
+		for (auto bound : { first.get(), last.get() })
+		{
+			if (bound->literal.index() != 0) loop.Set(pin++, (uint64_t)bound->Get<int64_t>());
+			else bound->end->Connect(loop, bound->pin, pin++);
+		}
+		prev->Connect(loop, flow, 0, true);
+		scope.add(var, std::make_unique<LocalVar>(Script::VarType{ Script::VarType::Int }, VarContent{ &loop,true }));
+		ctx.loop = &loop;
+		// without a guard the code after the loop hangs off its completion pin, with one off the node before the guard
+		if (constant && !empty)
+		{
+			ctx.merge = &loop;
+			ctx.flow = 1;
+		}
+		value = ctx;
+		prev = &loop;
+		current_loop = &loop;
+		flow = 0;
+	}
+
+	void VisitCountedForEnd(std::any& value) override
+	{
+		auto& [loop, merge, merge_flow, old] = std::any_cast<CountedLoopContext&>(value);
+		prev = merge;
+		flow = merge_flow;
+		current_loop = old;
+	}
+
+	// the type of a plain variable reference, empty when the name resolves to a function first or to nothing
+	std::optional<Script::VarType> VariableType(const std::string& id)
+	{
+		if (FunctionRegistry.Find(id).has_value() || compiler.GlobalFunctions.map.contains(id) || function_storage.map.contains(id) || inline_functions.contains(id)) return {};
+		auto var = scope.find(id);
+		if (!var) return {};
+		return var->type;
+	}
+
+	// foreach loops that only append, search or take an extreme of a list variable collapse into the list builtins,
+	// once the types show the builtin computes the same thing
+	bool VisitForEach(ForEachStatement& statement) override
+	{
+		auto list = dynamic_cast<Identifier*>(statement.Iterable());
+		auto list_type = list ? VariableType(list->Id()) : std::nullopt;
+		if (!list_type || list_type->type != Script::VarType::List) return false;
+		auto element = std::any_cast<Script::VarType>(list_type->extra);
+		if (statement.DeclaredType().type != Script::VarType::Unknown && statement.DeclaredType() != element) return false;
+		auto& def = statement.Var();
+		auto id = [](ExpressionNode* e) { return dynamic_cast<Identifier*>(e); };
+		auto is = [&](ExpressionNode* e, const std::string& name)
+			{
+				auto i = id(e);
+				return i && i->Id() == name;
+			};
+		auto call = [&](const char* name, std::vector<std::any> args) { return VisitCall(VisitIdentifier(name), args, {}); };
+		auto stmt = statement.Body();
+		if (auto block = dynamic_cast<BlockNode*>(stmt); block && block->Statements().size() == 1) stmt = block->Statements().front().get();
+		if (auto es = dynamic_cast<ExprStatement*>(stmt))
+		{
+			// for (x : b) InsertValue(a, GetListLength(a), x);
+			auto c = dynamic_cast<CallExpr*>(es->Expr());
+			if (!c || !is(c->Callee(), "InsertValue") || c->Args().size() != 3 || !is(c->Args()[2].get(), def)) return false;
+			auto target = id(c->Args()[0].get());
+			auto length = dynamic_cast<CallExpr*>(c->Args()[1].get());
+			if (!target || target->Id() == list->Id() || target->Id() == def || VariableType(target->Id()) != *list_type) return false;
+			if (!length || !is(length->Callee(), "GetListLength") || length->Args().size() != 1 || !is(length->Args()[0].get(), target->Id())) return false;
+			VisitExprStatement(call("ConcatenateList", { target->Eval(*this), list->Eval(*this) }));
+			return true;
+		}
+		auto branch = dynamic_cast<IfStatement*>(stmt);
+		auto cond = branch ? dynamic_cast<BinaryExpr*>(branch->Condition()) : nullptr;
+		if (!cond || branch->Otherwise()) return false;
+		auto then = branch->Then();
+		auto exits = false;
+		if (auto block = dynamic_cast<BlockNode*>(then))
+		{
+			auto& s = block->Statements();
+			if (s.size() == 2 && dynamic_cast<BreakStatement*>(s.back().get())) exits = true;
+			else if (s.size() != 1) return false;
+			then = s.front().get();
+		}
+		auto es = dynamic_cast<ExprStatement*>(then);
+		auto as = es ? dynamic_cast<Assignment*>(es->Expr()) : nullptr;
+		auto acc = as ? id(as->Target()) : nullptr;
+		if (!acc || as->Operator() != Assignment::Normal || acc->Id() == def || acc->Id() == list->Id() || !VariableType(acc->Id())) return false;
+		if (cond->Operator() == BinaryExpr::EQ)
+		{
+			// for (x : l) if (x == v) { found = true; break; }
+			auto value = is(cond->Left(), def) ? cond->Right() : is(cond->Right(), def) ? cond->Left() : nullptr;
+			if (!value || !dynamic_cast<Literal*>(as->Value())) return false;
+			if (auto i = id(value))
+			{
+				if (i->Id() == acc->Id() || VariableType(i->Id()) != element) return false;
+			}
+			else if (auto l = dynamic_cast<Literal*>(value))
+			{
+				if (std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(l->Eval(*this)))->retType != element) return false;
+			}
+			else return false;
+			scope.enter();
+			std::any found = call("ListIncludesThisValue", { list->Eval(*this), value->Eval(*this) });
+			VisitIfStatement(IfStatement::Start, found);
+			es->Visit(*this);
+			VisitIfStatement(IfStatement::End, found);
+			scope.exit();
+			return true;
+		}
+		// for (x : l) if (x > acc) acc = x;
+		if (exits || !is(as->Value(), def) || VariableType(acc->Id()) != element) return false;
+		if (element.type != Script::VarType::Int && element.type != Script::VarType::Float) return false;
+		if (!(is(cond->Left(), def) && is(cond->Right(), acc->Id())) && !(is(cond->Left(), acc->Id()) && is(cond->Right(), def))) return false;
+		bool larger;
+		switch (cond->Operator())
+		{
+		case BinaryExpr::GT:
+		case BinaryExpr::GE:
+			larger = is(cond->Left(), def);
+			break;
+		case BinaryExpr::LT:
+		case BinaryExpr::LE:
+			larger = is(cond->Right(), def);
+			break;
+		default:
+			return false;
+		}
+		scope.enter();
+		std::any nonempty = VisitBinary(BinaryExpr::GT, call("GetListLength", { list->Eval(*this) }), VisitLiteral(Literal::Int, int64_t{ 0 }));
+		VisitIfStatement(IfStatement::Start, nonempty);
+		auto ref = acc->Eval(*this);
+		auto current = acc->Eval(*this);
+		auto extreme = call(larger ? "GetMaximumValuefromList" : "GetMinimumValueFromList", { list->Eval(*this) });
+		VisitExprStatement(VisitAssignment(ref, Assignment::Normal, call(larger ? "TakeLargerValue" : "TakeSmallerValue", { current, extreme }), true));
+		VisitIfStatement(IfStatement::End, nonempty);
+		scope.exit();
+		return true;
+	}
+
 	void VisitForEachStart(Script::VarType type, const std::string& var, std::any& value) override
 	{
 		auto iterable = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(value));
+		if (iterable->retType.type == Script::VarType::Map)
+		{
+			auto keys = std::make_unique<ExprContent>(Script::VarType{ Script::VarType::List, std::any_cast<const MapEx&>(iterable->retType.extra).key });
+			ExprBuilder builder(*keys);
+			builder.Add(graph.CreateNode(DictionaryNode(GetListofKeysfromDictionaryEntityEntity, GetListofKeysfromDictionaryEntityListEntity, iterable->retType)));
+			builder.Combine(*iterable, 0);
+			iterable = std::move(keys);
+		}
 		if (iterable->retType.type != Script::VarType::List) throw std::runtime_error("Expression is not iterable");
 		if (type.type == Script::VarType::Unknown) type = std::any_cast<Script::VarType>(iterable->retType.extra);
 		else if (type != std::any_cast<Script::VarType>(iterable->retType.extra)) throw std::runtime_error("Iterator type mismatch");
 		auto& loop = graph.AddNode(ListIterationLoopInt);
 		iterable->Add(graph, layout());
 		AutoLayout(&loop);
-		if (iterable->flowStart)
-		{
-			prev->Connect(*iterable->flowStart, flow, 0, true);
-			prev = iterable->flowEnd;
-			flow = 0;
-		}
+		Chain(*iterable);
 		prev->Connect(loop, flow, 0, true);
 		iterable->end->Connect(loop, iterable->pin, 0);
 		scope.add(var, std::make_unique<LocalVar>(type, VarContent{ &loop,true }));
@@ -2721,12 +3915,13 @@ private:
 		}
 	}
 
-	std::any VisitAssignment(const std::any& ref, Assignment::Op op, const std::any& value) override
+	std::any VisitAssignment(const std::any& ref, Assignment::Op op, const std::any& value, bool discard) override
 	{
 		auto ref_value = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(ref));
 		if (ref_value->extra.index() != 1) throw std::runtime_error("Cannot assign to rvalue");
 		auto& lvalue = std::get<LValueContext>(ref_value->extra);
-		auto var_pin = lvalue.local ? 1 : 2;
+		auto var_pin = lvalue.local || !lvalue.variable.empty() ? 1 : 2;
+		if (lvalue.local || !lvalue.variable.empty()) Invalidate(ref_value->end);
 		auto expr = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(value));
 		if (expr->retType.type == Script::VarType::Tuple) throw std::runtime_error("Cannot use tuple in here");
 		auto newExpr = std::make_unique<ExprContent>();
@@ -2734,7 +3929,7 @@ private:
 		newExpr->retType = ref_value->retType.type == Script::VarType::Unknown ? expr->retType : ref_value->retType;
 		newExpr->extra = ref_value->extra;
 		INode* opn = nullptr;
-		if (!lvalue.local) NodeFactory::GetCustomVariable(ref_value->end, newExpr->retType);
+		if (!lvalue.local && !lvalue.entry.dictionary && lvalue.variable.empty() && ref_value->retType.type == Script::VarType::Unknown) NodeFactory::GetCustomVariable(ref_value->end, newExpr->retType);
 		auto ret = ref_value->end;
 		auto ret_pin = ref_value->pin;
 		switch (op)
@@ -2757,6 +3952,12 @@ private:
 			break;
 		case Assignment::Normal:
 		{
+			if (discard && !lvalue.local)
+			{
+				std::erase_if(ref_value->nodes, [ret](const auto& n) { return n.get() == ret; });
+				if (ref_value->start == ret) ref_value->start = nullptr;
+				ref_value->end = ret = nullptr;
+			}
 			auto n = builder.AddFlow(lvalue.CreateSetter(graph, newExpr->retType));
 			builder.Combine(*ref_value, -1);
 			if (expr->extra.index() == 3)
@@ -2844,7 +4045,8 @@ private:
 					break;
 				}
 				case Script::VarType::Map:
-					throw std::runtime_error("Cannot use map type for local variable");
+					builder.Combine(*AssembleDictionary(newExpr->retType, il), var_pin);
+					break;
 				default: throw std::runtime_error("Cannot use initializer list for this type");
 				}
 				return newExpr.release();
@@ -2885,9 +4087,10 @@ private:
 			auto& uf = std::get<4>(v->extra);
 			if (uf.global)
 			{
-				auto& func = compiler.GlobalFunctions.map[uf.id];
+				auto& func = compiler.GlobalFunctions.map.at(uf.id);
 				if (exprs.size() != func.parameters.size()) throw std::runtime_error("Call parameters count not equal");
-				auto call = builder.AddFlow(graph.CreateNode(*func.graph));
+				called.insert(uf.id);
+				auto call = builder.AddFlow(CreateComposite(*func.graph));
 				unsigned i = 0;
 				for (auto& arg : func.parameters)
 				{
@@ -2906,6 +4109,7 @@ private:
 				}
 				return expr.release();
 			}
+			if (auto it = inline_functions.find(uf.id); it != inline_functions.end() && !std::ranges::contains(inlining, it->second)) return Inline(*it->second, std::move(exprs));
 			auto& func = function_storage.map[uf.id];
 			if (exprs.size() != func.parameters.size()) throw std::runtime_error("Call parameters count not equal");
 			unsigned i = 0;
@@ -2965,6 +4169,76 @@ private:
 		return expr.release();
 	}
 
+	ExprContent* Inline(FunctionNode& function, std::vector<std::unique_ptr<ExprContent>> args)
+	{
+		auto& parameters = function.Parameters();
+		if (args.size() != parameters.size()) throw std::runtime_error("Call parameters count not equal");
+		// arguments are evaluated in order ahead of the body, just like the SetLocalVariable chain of a real call
+		auto prologue = std::make_unique<ExprContent>();
+		auto append = [&prologue](std::unique_ptr<ExprContent> step)
+		{
+			ExprBuilder(*step).Combine(*prologue, -1);
+			prologue = std::move(step);
+		};
+		auto suspended = scope.suspend();
+		scope.enter();
+		for (std::size_t i = 0; i < args.size(); i++)
+		{
+			auto& p = parameters[i];
+			auto& e = args[i];
+			if (e->retType != p.Type()) throw std::runtime_error("Parameter type mismatch");
+			if (function.Writes(p.Id()) || (!function.Pure() && e->literal.index() == 0))
+			{
+				auto n = &graph.AddNode(NodeFactory::GetLocalVariable(graph, p.Type()));
+				AutoLayout(n);
+				n->SetComment(p.Id());
+				auto step = std::make_unique<ExprContent>();
+				ExprBuilder builder(*step);
+				auto set = builder.AddFlow(NodeFactory::SetLocalVariable(graph, p.Type()));
+				n->Connect(*set, 0, 0);
+				if (e->literal.index() == 0) builder.Combine(*e, 1);
+				else SetLiteral(*set, 1, *e, p.Type());
+				append(std::move(step));
+				scope.add(p.Id(), std::make_unique<LocalVar>(p.Type(), VarContent{ n }));
+				continue;
+			}
+			scope.add(p.Id(), std::make_unique<LocalVar>(p.Type(), BoundValue{ e->end, e->pin, e->literal }));
+			if (e->literal.index() == 0) append(std::move(e));
+		}
+		inlining.push_back(&function);
+		auto body = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(function.EvalInline(*this)));
+		inlining.pop_back();
+		scope.exit();
+		scope.resume(std::move(suspended));
+		body->extra = {};
+		if (auto ret = function.Ret(); ret.has_value())
+		{
+			if (body->retType != *ret) throw std::runtime_error("Return type mismatch");
+		}
+		else
+		{
+			body->retType = {};
+			body->literal = {};
+			body->end = nullptr;
+			body->pin = 0;
+		}
+		if (body->literal.index() != 0)
+		{
+			if (!prologue->flowStart) return body.release();
+			auto value = std::make_unique<ExprContent>(body->retType);
+			auto n = ExprBuilder(*value).Add(NodeFactory::GetLocalVariable(graph, body->retType));
+			SetLiteral(*n, 0, *body, body->retType);
+			value->pin = 1;
+			body = std::move(value);
+		}
+		auto end = body->end;
+		auto pin = body->pin;
+		ExprBuilder(*body).Combine(*prologue, -1);
+		body->end = end;
+		body->pin = pin;
+		return body.release();
+	}
+
 	std::any VisitIdentifier(const std::string& id) override
 	{
 		if (auto func = FunctionRegistry.Find(id); func.has_value())
@@ -2981,7 +4255,7 @@ private:
 			expr->extra = UserFunction{ id ,true };
 			return expr.release();
 		}
-		if (auto func = function_storage.map.find(id); func != function_storage.map.end())
+		if (function_storage.map.contains(id) || inline_functions.contains(id))
 		{
 			auto expr = std::make_unique<ExprContent>();
 			expr->retType.type = Script::VarType::Function;
@@ -2990,8 +4264,34 @@ private:
 		}
 		auto var = scope.find(id);
 		if (!var) throw std::runtime_error("Undefined symbol: " + id);
-		auto& [content, iterator] = std::any_cast<VarContent&>(var->content);
 		auto expr = std::make_unique<ExprContent>();
+		if (auto variable = std::any_cast<GraphVariable>(&var->content))
+		{
+			auto& n = graph_variables[variable->name];
+			if (!n)
+			{
+				n = &graph.AddNode(NodeFactory::NodeGraphVariable(graph, var->type, false));
+				n->Set(0, variable->name);
+				n->SetComment(variable->name);
+				AutoLayout(n);
+			}
+			expr->end = n;
+			expr->pin = 0;
+			expr->retType = var->type;
+			expr->extra = LValueContext{ nullptr,{},{},variable->name };
+			return expr.release();
+		}
+		if (auto bound = std::any_cast<BoundValue>(&var->content))
+		{
+			expr->literal = bound->literal;
+			expr->retType = var->type;
+			expr->end = bound->node;
+			expr->pin = bound->pin;
+			expr->safe = true;
+			return expr.release();
+		}
+		auto& [content, iterator] = std::any_cast<VarContent&>(var->content);
+		expr->safe = true;
 		if (std::holds_alternative<unsigned>(content))
 		{
 			auto pin = std::get<unsigned>(content);
@@ -3027,9 +4327,9 @@ private:
 		return expr.release();
 	}
 
-	std::any VisitIncrement(const std::any& ref, bool inv, bool pre) override
+	std::any VisitIncrement(const std::any& ref, bool inv, bool pre, bool discard) override
 	{
-		if (pre) return VisitAssignment(ref, inv ? Assignment::Sub : Assignment::Add, new ExprContent(1));
+		if (pre || discard) return VisitAssignment(ref, inv ? Assignment::Sub : Assignment::Add, new ExprContent(1), discard);
 		auto ref_value = std::any_cast<ExprContent*>(ref);
 		if (ref_value->extra.index() != 1) throw std::runtime_error("Cannot assign to rvalue");
 		auto expr = std::make_unique<ExprContent>();
@@ -3037,7 +4337,7 @@ private:
 		auto& lvalue = std::get<LValueContext>(ref_value->extra);
 		expr->retType = ref_value->retType;
 		expr->extra = ref_value->extra;
-		if (!lvalue.local) NodeFactory::GetCustomVariable(ref_value->end, expr->retType);
+		if (!lvalue.local && !lvalue.entry.dictionary && lvalue.variable.empty()) NodeFactory::GetCustomVariable(ref_value->end, expr->retType);
 		auto ret = ref_value->end;
 		auto ret_pin = ref_value->pin;
 		auto tmp = builder.Add(NodeFactory::GetLocalVariable(graph, expr->retType));
@@ -3047,7 +4347,7 @@ private:
 		ret->Connect(*n, ret_pin, 1);
 		ref_value->end = ret;
 		ref_value->pin = ret_pin;
-		auto e = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(VisitAssignment(ref, inv ? Assignment::Sub : Assignment::Add, new ExprContent(1))));
+		auto e = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(VisitAssignment(ref, inv ? Assignment::Sub : Assignment::Add, new ExprContent(1), false)));
 		std::swap(*expr, *e);
 		builder.Combine(*e, 1);
 		expr->end = tmp;
@@ -3055,6 +4355,14 @@ private:
 		return expr.release();
 	}
 
+	bool VisitInvolution(UnaryExpr::Op op, const std::any& value) override
+	{
+		auto v = std::any_cast<ExprContent*>(value);
+		if (!Simplifier::Find(op, *v)) return false;
+		simplified += 2;
+		return true;
+	}
+
 	std::any VisitUnary(UnaryExpr::Op op, const std::any& value) override
 	{
 		auto v = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(value));
@@ -3066,6 +4374,7 @@ private:
 		case UnaryExpr::Negate:
 			result = builder.Add(NodeFactory::Sub(graph, ExprContent(0), *v));
 			expr->retType = v->retType;
+			if (auto x = AsLeaf(*v)) expr->shape = ExprContent::Shape{ ExprContent::Shape::Negate, {}, { *x } };
 			builder.Combine(*v, 1);
 			break;
 		case UnaryExpr::LogicalNOT:
@@ -3077,16 +4386,72 @@ private:
 			expr->retType = v->retType;
 			break;
 		}
+		expr->safe = v->Safe();
 		builder.Combine(*v, 0);
 		expr->start = result;
 		expr->pin = 0;
 		return expr.release();
 	}
 
+	std::any ShortCircuit(BinaryExpr::Op op, std::unique_ptr<ExprContent> left, std::unique_ptr<ExprContent> right)
+	{
+		if (left->retType.type != Script::VarType::Bool || right->retType.type != Script::VarType::Bool) throw std::runtime_error("Unsupported variable type for logical");
+		if (left->literal.index() != 0)
+		{
+			if (left->Get<bool>() == (op == BinaryExpr::LogAND)) return right.release();
+			return left.release();
+		}
+		Script::VarType type{ Script::VarType::Bool };
+		auto arm = op == BinaryExpr::LogAND ? 0 : 1;
+		auto expr = std::make_unique<ExprContent>();
+		ExprBuilder builder(*expr);
+		auto tmp = builder.Add(NodeFactory::GetLocalVariable(graph, type));
+		auto init = expr->start = builder.AddFlow(NodeFactory::SetLocalVariable(graph, type));
+		tmp->Connect(*init, 0, 0);
+		builder.Combine(*left, 1);
+		auto br = builder.AddFlow(graph.CreateNode(DoubleBranch));
+		tmp->Connect(*br, 1, 0);
+		auto set = expr->nodes.emplace_back(NodeFactory::SetLocalVariable(graph, type)).get();
+		tmp->Connect(*set, 0, 0);
+		right->end->Connect(*set, right->pin, 1);
+		// the right operand runs on the arm, joined there like a statement; the other arm falls through to the join
+		if (right->flowStart) br->Connect(*right->flowStart, arm, 0, true);
+		for (auto id : right->branches) for (auto& n : right->nodes) if (n->Id() == id) br->Connect(*n, arm, 0, true);
+		if (right->flowEnd) right->flowEnd->Connect(*set);
+		else br->Connect(*set, arm, 0, true);
+		for (auto& n : right->nodes) expr->nodes.emplace_back(std::move(n));
+		right->nodes.clear();
+		expr->retType = type;
+		expr->end = tmp;
+		expr->pin = 1;
+		expr->flowEnd = nullptr;
+		expr->branch = true;
+		return expr.release();
+	}
+
 	std::any VisitBinary(BinaryExpr::Op op, const std::any& l, const std::any& r) override
 	{
 		auto left = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(l));
 		auto right = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(r));
+		if (auto rule = Simplifier::Find(op, *left, *right))
+		{
+			simplified += rule->eliminated;
+			switch (rule->result)
+			{
+			case Simplifier::Left:
+				return left.release();
+			case Simplifier::Right:
+				return right.release();
+			case Simplifier::Cancel:
+				if (left->retType.type == Script::VarType::Float) return new ExprContent(0.0f);
+				return new ExprContent(int64_t{ 0 });
+			case Simplifier::Reciprocal:
+				op = BinaryExpr::Mul;
+				right->literal = 1.0f / std::get<float>(right->literal);
+				break;
+			}
+		}
+		if ((op == BinaryExpr::LogAND || op == BinaryExpr::LogOR) && (right->flowStart || right->nodes.size() > EAGER_COST_LIMIT)) return ShortCircuit(op, std::move(left), std::move(right));
 		auto expr = std::make_unique<ExprContent>();
 		ExprBuilder builder(*expr);
 		INode* result = nullptr;
@@ -3118,6 +4483,7 @@ private:
 		case BinaryExpr::GE:
 			result = builder.Add(NodeFactory::Compare(graph, *left, *right, op));
 			expr->retType = { Script::VarType::Bool };
+			if (auto a = AsLeaf(*left), b = AsLeaf(*right); a && b) expr->shape = ExprContent::Shape{ ExprContent::Shape::Compare, op, { *a, *b } };
 			break;
 		case BinaryExpr::EQ:
 			result = builder.Add(NodeFactory::Equal(graph, *left, *right));
@@ -3167,6 +4533,8 @@ private:
 			expr->retType = left->retType;
 			break;
 		}
+		// a zero divisor faults, everything else is as safe as its operands
+		expr->safe = op != BinaryExpr::Div && op != BinaryExpr::Mod && left->Safe() && right->Safe();
 		builder.Combine(*left, 0);
 		expr->start = result;
 		builder.Combine(*right, 1);
@@ -3174,190 +4542,1148 @@ private:
 		return expr.release();
 	}
 
-	std::any VisitTernary(const std::any& e1, const std::any& e2, const std::any& e3) override
+	static std::optional<ExprContent::Leaf> AsLeaf(const ExprContent& e)
+	{
+		if (e.literal.index() != 0) return ExprContent::Leaf{ e.retType, nullptr, 0, e.literal };
+		if (!e.nodes.empty() || e.flowStart || e.branch || !e.end) return std::nullopt;
+		return ExprContent::Leaf{ e.retType, e.end, e.pin, {} };
+	}
+
+	static bool Number(const ExprContent::Leaf& e, int v)
+	{
+		if (e.literal.index() == 1) return std::get<int64_t>(e.literal) == v;
+		if (e.literal.index() == 2) return std::get<float>(e.literal) == static_cast<float>(v);
+		return false;
+	}
+
+	std::unique_ptr<ExprContent> Builtin(const std::string& name, const std::vector<ExprContent::Leaf>& operands)
+	{
+		std::vector<std::any> args;
+		for (auto& leaf : operands)
+		{
+			auto arg = new ExprContent(leaf.literal);
+			arg->retType = leaf.type;
+			arg->end = leaf.node;
+			arg->pin = leaf.pin;
+			args.emplace_back(arg);
+		}
+		return std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(VisitCall(VisitIdentifier(name), args, std::nullopt)));
+	}
+
+	// min, max, clamp, abs and sign spelled as a ternary over int or float leaves, lowered to the builtin instead of a branch
+	std::unique_ptr<ExprContent> Idiom(const ExprContent& cond, const ExprContent& then, const ExprContent& other)
+	{
+		using Shape = ExprContent::Shape;
+		if (!cond.shape || cond.shape->kind != Shape::Compare) return nullptr;
+		auto op = cond.shape->op;
+		auto& l = cond.shape->operands[0];
+		auto& r = cond.shape->operands[1];
+		if (l.type != r.type || (l.type.type != Script::VarType::Int && l.type.type != Script::VarType::Float)) return nullptr;
+		auto less = op == BinaryExpr::LT || op == BinaryExpr::LE;
+		if (!less && op != BinaryExpr::GT && op != BinaryExpr::GE) return nullptr;
+		auto strict = op == BinaryExpr::LT || op == BinaryExpr::GT;
+		auto& small = less ? l : r;
+		auto& big = less ? r : l;
+		auto a = AsLeaf(then), b = AsLeaf(other);
+		if (a && (*a == small || *a == big))
+		{
+			// upper when the arm taken for x above the bound is the bound
+			auto upper = *a == small;
+			auto& x = upper ? big : small;
+			// x > hi ? hi : x
+			if (b && *b == x)
+			{
+				auto expr = Builtin(upper ? "TakeSmallerValue" : "TakeLargerValue", { x, *a });
+				expr->shape = Shape{ upper ? Shape::Smaller : Shape::Larger, op, { x, *a } };
+				return expr;
+			}
+			// x > hi ? hi : (x < lo ? lo : x)
+			if (auto& inner = other.shape; inner && inner->kind == (upper ? Shape::Larger : Shape::Smaller) && inner->operands[0] == x)
+			{
+				auto& lo = upper ? inner->operands[1] : *a;
+				auto& hi = upper ? *a : inner->operands[1];
+				return Builtin("RangeLimitingOperation", { x, lo, hi });
+			}
+		}
+		auto x = Number(r, 0) ? &l : Number(l, 0) ? &r : nullptr;
+		if (!x) return nullptr;
+		// positive when the zero sits on the small side, so the condition holds for x above zero
+		auto positive = Number(small, 0);
+		auto negated = [&](const ExprContent& e) { return e.shape && e.shape->kind == Shape::Negate && e.shape->operands[0] == *x; };
+		// x < 0 ? -x : x
+		if ((negated(then) && b && *b == *x && !positive) || (a && *a == *x && negated(other) && positive)) return Builtin("AbsoluteValueOperation", { *x });
+		// x > 0 ? 1 : (x < 0 ? -1 : 0)
+		auto& inner = other.shape;
+		if (!strict || !a || !inner || inner->kind != Shape::Choice || (inner->op != BinaryExpr::LT && inner->op != BinaryExpr::GT)) return nullptr;
+		auto& il = inner->operands[0];
+		auto& ir = inner->operands[1];
+		if (!(il == *x && Number(ir, 0)) && !(ir == *x && Number(il, 0))) return nullptr;
+		auto sign = positive ? 1 : -1;
+		if (Number(inner->op == BinaryExpr::LT ? il : ir, 0) == positive || !Number(*a, sign) || !Number(inner->operands[2], -sign) || !Number(inner->operands[3], 0)) return nullptr;
+		return std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(VisitCast(then.retType, Builtin("SignOperation", { *x }).release())));
+	}
+
+	std::any Select(std::unique_ptr<ExprContent> cond, std::unique_ptr<ExprContent> then, std::unique_ptr<ExprContent> other, unsigned index)
+	{
+		if (cond->literal.index() != 0) return (cond->Get<bool>() ? then : other).release();
+		auto expr = std::make_unique<ExprContent>();
+		ExprBuilder builder(*expr);
+		auto as = builder.Add(graph.CreateNode(AssemblyListInt));
+		as->Set(0, (uint64_t)2);
+		as->Set(0, index, true);
+		unsigned pin = 1;
+		for (auto arm : { other.get(), then.get() })
+		{
+			as->Set(pin, index, false);
+			switch (arm->literal.index())
+			{
+			case 0:
+				expr->start = as;
+				builder.Combine(*arm, pin);
+				break;
+			case 1:
+				as->Set(pin, index, (uint64_t)arm->Get<int64_t>());
+				break;
+			case 2:
+				as->Set(pin, index, arm->Get<float>());
+				break;
+			case 3:
+				as->Set(pin, index, std::get<std::string>(arm->literal));
+				break;
+			case 4:
+				as->Set(pin, index, Enum{ arm->Get<bool>() }, ServerVarType::Boolean);
+				break;
+			}
+			++pin;
+		}
+		auto get = builder.Add(graph.CreateNode(GetCorrespondingValueFromListInt));
+		get->Set(0, index, false);
+		get->Set(0, index, true);
+		as->Connect(*get, 0, 0);
+		auto cast = expr->start = builder.Add(NodeFactory::Cast(graph, *cond, Script::VarType{ Script::VarType::Int }));
+		builder.Combine(*cond, 0);
+		cast->Connect(*get, 0, 1);
+		expr->retType = then->retType;
+		expr->end = get;
+		expr->pin = 0;
+		return expr.release();
+	}
+
+	std::any VisitTernary(const std::any& e1, const std::any& e2, const std::any& e3) override
+	{
+		auto cond = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(e1));
+		auto then = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(e2));
+		auto other = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(e3));
+		if (then->retType != other->retType) throw std::runtime_error("Type mismatch in conditional expression");
+		if (cond->retType.type != Script::VarType::Bool) throw std::runtime_error("Condition expression must be boolean");
+		if (auto idiom = Idiom(*cond, *then, *other)) return idiom.release();
+		std::optional<ExprContent::Shape> choice;
+		if (auto a = AsLeaf(*then), b = AsLeaf(*other); a && b && cond->shape && cond->shape->kind == ExprContent::Shape::Compare)
+		{
+			choice = ExprContent::Shape{ ExprContent::Shape::Choice, cond->shape->op, cond->shape->operands };
+			choice->operands.append_range(std::array{ *a, *b });
+		}
+		// both arms run before the pick, so only arms that cannot fault may drop the guard
+		if (auto index = NodeFactory::ListElementIndex(then->retType); index.has_value() && then->Safe() && other->Safe() && then->nodes.size() + other->nodes.size() <= EAGER_COST_LIMIT)
+		{
+			auto expr = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(Select(std::move(cond), std::move(then), std::move(other), *index)));
+			expr->shape = std::move(choice);
+			return expr.release();
+		}
+		auto expr = std::make_unique<ExprContent>();
+		ExprBuilder builder(*expr);
+		auto tmp = builder.Add(NodeFactory::GetLocalVariable(graph, then->retType));
+		auto br = expr->start = builder.AddFlow(graph.CreateNode(DoubleBranch));
+		builder.Combine(*cond, 0);
+		auto set = expr->start = builder.AddFlow(NodeFactory::SetLocalVariable(graph, then->retType));
+		SetLiteral(*set, 1, *then, then->retType);
+		builder.Combine(*then, 1);
+		tmp->Connect(*set, 0, 0);
+		expr->flowEnd = br;
+		set = expr->start = builder.AddFlow(NodeFactory::SetLocalVariable(graph, other->retType), 1);
+		SetLiteral(*set, 1, *other, other->retType);
+		builder.Combine(*other, 1);
+		tmp->Connect(*set, 0, 0);
+		expr->end = tmp;
+		expr->retType = then->retType;
+		expr->pin = 1;
+		expr->flowEnd = nullptr;
+		expr->branch = true;
+		expr->shape = std::move(choice);
+		return expr.release();
+	}
+
+	std::any VisitCast(Script::VarType type, const std::any& value) override
+	{
+		auto v = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(value));
+		if (v->retType == type) return v.release();
+		auto expr = std::make_unique<ExprContent>();
+		ExprBuilder builder(*expr);
+		builder.Add(NodeFactory::Cast(graph, *v, type));
+		builder.Combine(*v, 0);
+		expr->retType = type;
+		return expr.release();
+	}
+
+	std::any VisitMemberAccess(const std::any& value, const std::any& member, std::optional<Script::VarType> type) override
+	{
+		auto v = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(value));
+		auto m = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(member));
+		auto expr = std::make_unique<ExprContent>();
+		ExprBuilder builder(*expr);
+		switch (v->retType.type)
+		{
+		case Script::VarType::Entity:
+		{
+			if (m->retType.type != Script::VarType::String) throw std::runtime_error("Member not defined");
+			if (type.has_value()) expr->retType = *type;
+			std::optional<decltype(loads)::key_type> key;
+			if (m->literal.index() != 0)
+			{
+				auto& name = std::get<std::string>(m->literal);
+				expr->extra = LValueContext{ nullptr,v->end,name,v->pin };
+				// getters are pulled on every use, so a load already placed in the graph can stand in for a new one
+				if (v->end && v->nodes.empty() && !v->flowStart && !v->branch && expr->retType.type != Script::VarType::Unknown) key.emplace(v->end, v->pin, name, NodeFactory::VariableIndex(expr->retType));
+				if (auto it = key ? loads.find(*key) : loads.end(); it != loads.end())
+				{
+					if (auto n = graph.Find(it->second))
+					{
+						expr->end = n;
+						break;
+					}
+				}
+			}
+			else expr->extra = LValueContext{ nullptr,v->end,m->end,v->pin,m->pin };
+			auto n = builder.Add(NodeFactory::GetCustomVariable(graph, expr->retType));
+			if (m->literal.index() != 0) n->Set(1, std::get<std::string>(m->literal));
+			if (key) loads[*key] = n->Id();
+			builder.Combine(*v, 0);
+			builder.Combine(*m, 1);
+			break;
+		}
+		case Script::VarType::Vec:
+		{
+			if (m->literal.index() != 3) throw std::runtime_error("Member not defined");
+			auto id = std::get<std::string>(m->literal);
+			if (id == "x") expr->pin = 0;
+			else if (id == "y") expr->pin = 1;
+			else if (id == "z") expr->pin = 2;
+			else throw std::runtime_error("Member not defined");
+			expr->retType.type = Script::VarType::Float;
+			if (v->nodes.empty())
+			{
+				expr->end = Decompose(*v, Split3DVector);
+				break;
+			}
+			builder.Add(graph.CreateNode(Split3DVector));
+			builder.Combine(*v, 0);
+			break;
+		}
+		case Script::VarType::List:
+		{
+			if (m->retType.type != Script::VarType::Int) throw std::runtime_error("Member not defined");
+			auto n = builder.Add(graph.CreateNode(GetCorrespondingValueFromListInt));
+			builder.Combine(*v, 0);
+			builder.Combine(*m, 1);
+			if (m->literal.index() != 0) n->Set(1, (uint64_t)m->Get<int64_t>());
+			expr->retType = std::any_cast<Script::VarType&>(v->retType.extra);
+			break;
+		}
+		case Script::VarType::Tuple:
+		{
+			if (m->literal.index() != 1) throw std::runtime_error("Tuple index must be integer literal");
+			auto& types = std::any_cast<const std::vector<Script::VarType>&>(v->retType.extra);
+			auto index = m->Get<int64_t>();
+			if (index < 0 || index >= (int64_t)types.size()) throw std::runtime_error("Tuple index out of range");
+			auto source = v->end;
+			builder.Combine(*v, -1);
+			expr->retType = types[index];
+			expr->end = source;
+			expr->pin = (int)index;
+			break;
+		}
+		case Script::VarType::Map:
+		{
+			auto& [key, value] = std::any_cast<const MapEx&>(v->retType.extra);
+			if (m->retType != key && !(m->literal.index() == 1 && key.type == Script::VarType::Guid)) throw std::runtime_error("Dictionary key type mismatch");
+			auto n = builder.Add(graph.CreateNode(DictionaryNode(QueryDictionaryValuebyKeyEntityEntity, QueryDictionaryValuebyKeyEntityListEntity, v->retType)));
+			std::function<void(INode&)> setter;
+			if (m->literal.index() != 0)
+			{
+				SetLiteralNormal(*n, 1, *m, key);
+				setter = [literal = m->literal, key](INode& node) { SetLiteralNormal(node, 1, ExprContent(literal), key); };
+			}
+			else setter = [end = m->end, pin = m->pin](INode& node) { end->Connect(node, pin, 1); };
+			expr->extra = LValueContext{ nullptr,{},{ v->end,v->pin,std::move(setter),v->retType } };
+			expr->retType = value;
+			builder.Combine(*v, 0);
+			builder.Combine(*m, 1);
+			break;
+		}
+		default: throw std::runtime_error("Type haven't member access operation");
+		}
+		return expr.release();
+	}
+
+	std::any VisitConstruct(Script::VarType type, const std::vector<std::any>& args) override
+	{
+		throw std::runtime_error("Unimplemented");
+	}
+
+	std::any VisitInitializerList(const std::vector<std::any>& values) override
+	{
+		auto list = std::make_unique<ExprContent>();
+		std::vector<std::shared_ptr<ExprContent>> eps;
+		for (auto& v : values) eps.emplace_back(std::shared_ptr<ExprContent>(std::any_cast<ExprContent*>(v)));
+		list->extra = std::move(eps);
+		return list.release();
+	}
+
+	void VisitReturn(const std::any& value) override
+	{
+		if (!value.has_value()) return;
+		auto v = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(value));
+		if (v->retType != function_header.type) throw std::runtime_error("Return type mismatch");
+		auto r = function_header.ret;
+		if (!r)
+		{
+			// a pure tail return of a composite feeds the output pin without going through a return local
+			if (v->literal.index() != 0)
+			{
+				auto n = &graph.AddNode(NodeFactory::GetLocalVariable(graph, v->retType));
+				AutoLayout(n);
+				SetLiteral(*n, 0, *v, v->retType);
+				std::lock_guard lock(compiler.composite_pins);
+				DefinePin(*n, v->retType, 1, true, true);
+				graph.SetCompositePin(*n, PinType::Output, 1, 0);
+				return;
+			}
+			v->Add(graph, layout());
+			Chain(*v);
+			std::lock_guard lock(compiler.composite_pins);
+			graph.SetCompositePin(*v->end, PinType::Output, v->pin, 0);
+			return;
+		}
+		auto& n = graph.AddNode(NodeFactory::SetLocalVariable(graph, v->retType));
+		v->Add(graph, layout());
+		AutoLayout(&n);
+		r->Connect(n, 0, 0);
+		v->end->Connect(n, v->pin, 1);
+		Chain(*v);
+		prev->Connect(n, flow, 0, true);
+		prev = &n;
+	}
+};
+
+// splits an outline-free module into one task per event handler and local function body,
+// each lowered by its own generator into a staging buffer
+class ModuleStage
+{
+	struct Task
+	{
+		std::unique_ptr<StagingGraph> buffer;
+		std::unique_ptr<NodeGenerator> generator;
+		std::function<void()> body;
+		std::string name;
+	};
+
+	IGraph& graph;
+	std::string module;
+	std::vector<Task> tasks;
+	std::vector<StagedBuffer> buffers;
+
+	NodeGenerator& Spawn(const NodeGenerator& declarations, const std::vector<GraphVarDef*>& vars)
+	{
+		auto& task = tasks.emplace_back(std::make_unique<StagingGraph>((std::uint32_t)tasks.size()));
+		auto& g = *(task.generator = std::make_unique<NodeGenerator>(*task.buffer, declarations.compiler));
+		g.function_storage = declarations.function_storage;
+		g.inline_functions = declarations.inline_functions;
+		g.scope.enter();
+		for (auto v : vars) v->Visit(g);
+		return g;
+	}
+
+	// the header is lowered up front so later declarations can call the function
+	void Declare(NodeGenerator& g, FunctionNode& f)
+	{
+		auto& task = tasks.back();
+		task.name = "function " + f.Name();
+		auto activation = task.buffer->Activate();
+		g.scope.enter();
+		g.VisitFunction(f.Name(), f.Ret(), f.Parameters());
+		task.body = [&g, &f]
+			{
+				f.VisitBody(g);
+				g.scope.exit();
+			};
+	}
+
+	// whether expanding f can call back into f through the inlined functions it reaches
+	static bool Reenters(const FunctionNode& f, const std::unordered_map<std::string, FunctionNode*>& inlined)
+	{
+		std::vector<const FunctionNode*> work{ &f };
+		std::unordered_set<const FunctionNode*> seen;
+		while (!work.empty())
+		{
+			auto current = work.back();
+			work.pop_back();
+			for (auto& name : current->Calls())
+			{
+				auto it = inlined.find(name);
+				if (it == inlined.end()) continue;
+				if (it->second == &f) return true;
+				if (seen.insert(it->second).second) work.push_back(it->second);
+			}
+		}
+		return false;
+	}
+
+public:
+	ModuleStage(IGraph& graph, std::string module, const RootNode& root, Compiler& compiler) : graph(graph), module(std::move(module))
+	{
+		// only collects declarations, so it never emits into the module graph
+		NodeGenerator declarations(graph, compiler);
+		declarations.scope.enter();
+		std::vector<GraphVarDef*> vars;
+		std::vector<FunctionNode*> inlined;
+		for (auto& d : root.Declarations())
+		{
+			if (auto v = dynamic_cast<GraphVarDef*>(d.get()))
+			{
+				v->Visit(declarations);
+				vars.push_back(v);
+				continue;
+			}
+			auto f = dynamic_cast<FunctionNode*>(d.get());
+			if (f && declarations.VisitInlineFunction(*f))
+			{
+				inlined.push_back(f);
+				continue;
+			}
+			auto& g = Spawn(declarations, vars);
+			if (!f)
+			{
+				if (auto e = dynamic_cast<EventNode*>(d.get())) tasks.back().name = "event " + e->Name();
+				tasks.back().body = [&g, d = d.get()] { d->Visit(g); };
+				continue;
+			}
+			Declare(g, *f);
+			declarations.function_storage.map[f->Name()] = g.function_storage.map.at(f->Name());
+		}
+		// an inlined function that can reach itself through other inlined ones also gets a real body,
+		// which the expansion calls once it re-enters the function
+		for (auto f : inlined)
+		{
+			if (!Reenters(*f, declarations.inline_functions)) continue;
+			auto& g = Spawn(declarations, vars);
+			g.inline_functions.erase(f->Name());
+			Declare(g, *f);
+			auto& header = g.function_storage.map.at(f->Name());
+			declarations.function_storage.map[f->Name()] = header;
+			for (auto& t : tasks) t.generator->function_storage.map[f->Name()] = header;
+		}
+	}
+
+	std::size_t Size() const { return tasks.size(); }
+
+	void Run(std::size_t i)
+	{
+		Trace::Span span("Declaration", tasks[i].name);
+		Memory::Scope memory("Codegen", module);
+		auto activation = tasks[i].buffer->Activate();
+		tasks[i].body();
+	}
+
+	// replays the buffers in declaration order, stacking them the way a single generator lays them out
+	std::size_t Merge()
+	{
+		std::size_t simplified = 0;
+		for (auto& [buffer, generator, body, name] : tasks)
+		{
+			buffers.push_back(buffer->Release(generator->y));
+			simplified += generator->simplified;
+		}
+		Replayer replayer(graph);
+		for (auto& b : buffers) replayer.Run(b);
+		return simplified;
+	}
+
+	const std::vector<StagedBuffer>& Buffers() const { return buffers; }
+
+	std::set<std::string> Called() const
+	{
+		std::set<std::string> called;
+		for (auto& t : tasks) called.insert_range(t.generator->called);
+		return called;
+	}
+};
+
+// bumped by hand whenever the parser and AST passes of GIScript or the lowering here change what a module compiles to,
+// so entries written by an older compiler are never replayed
+static constexpr std::uint32_t COMPILER_VERSION = 3;
+static constexpr std::uint32_t CACHE_FORMAT = 3;
+
+class CacheWriter
+{
+	std::string data;
+
+public:
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	void Write(const T& value) { data.append((const char*)&value, sizeof(T)); }
+
+	void Write(const std::string& value)
+	{
+		Write((std::uint32_t)value.size());
+		data.append(value);
+	}
+
+	void Write(const std::u8string& value)
+	{
+		Write((std::uint32_t)value.size());
+		data.append((const char*)value.data(), value.size());
+	}
+
+	template<typename T>
+	void Write(const std::vector<T>& values)
+	{
+		Write((std::uint32_t)values.size());
+		for (auto& v : values) Write(v);
+	}
+
+	template<typename A, typename B>
+	void Write(const std::pair<A, B>& value)
+	{
+		Write(value.first);
+		Write(value.second);
+	}
+
+	void Write(const NodeGraph::VarType& value)
+	{
+		Write((std::uint8_t)value.index());
+		std::visit([&](auto v) { Write(v); }, value);
+	}
+
+	void Write(const CompositeRef& value) { Write(value.name); }
+
+	void Write(const StagedValue& value)
+	{
+		Write((std::uint8_t)value.index());
+		std::visit([&](const auto& v) { Write(v); }, value);
+	}
+
+	void Write(const StagedOp& op)
+	{
+		Write(op.kind);
+		Write(op.node);
+		Write(op.args);
+	}
+
+	void Write(const StagedBuffer& buffer)
+	{
+		Write(buffer.height);
+		Write(buffer.log);
+	}
+
+	const std::string& Data() const { return data; }
+};
+
+class CacheReader
+{
+	const std::string& data;
+	std::size_t pos = 0;
+
+	std::uint32_t Count()
+	{
+		std::uint32_t n;
+		Read(n);
+		if (n > data.size() - pos) throw std::runtime_error("Corrupted cache entry");
+		return n;
+	}
+
+	template<typename V, std::size_t... I>
+	void ReadAlternative(V& value, std::size_t index, std::index_sequence<I...>)
+	{
+		if (!((index == I && (Read(value.template emplace<I>()), true)) || ...)) throw std::runtime_error("Corrupted cache entry");
+	}
+
+public:
+	explicit CacheReader(const std::string& data) : data(data) {}
+
+	bool End() const { return pos == data.size(); }
+
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	void Read(T& value)
+	{
+		if (sizeof(T) > data.size() - pos) throw std::runtime_error("Corrupted cache entry");
+		std::memcpy(&value, data.data() + pos, sizeof(T));
+		pos += sizeof(T);
+	}
+
+	void Read(std::string& value)
 	{
-		auto cond = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(e1));
-		auto then = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(e2));
-		auto other = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(e3));
-		if (then->retType != other->retType) throw std::runtime_error("Type mismatch in conditional expression");
-		auto expr = std::make_unique<ExprContent>();
-		ExprBuilder builder(*expr);
-		auto tmp = builder.Add(NodeFactory::GetLocalVariable(graph, then->retType));
-		auto br = expr->start = builder.AddFlow(graph.CreateNode(DoubleBranch));
-		builder.Combine(*cond, 0);
-		auto set = expr->start = builder.AddFlow(NodeFactory::SetLocalVariable(graph, then->retType));
-		SetLiteral(*set, 1, *then, then->retType);
-		builder.Combine(*then, 1);
-		tmp->Connect(*set, 0, 0);
-		expr->flowEnd = br;
-		set = expr->start = builder.AddFlow(NodeFactory::SetLocalVariable(graph, other->retType), 1);
-		SetLiteral(*set, 1, *other, other->retType);
-		builder.Combine(*other, 1);
-		tmp->Connect(*set, 0, 0);
-		expr->end = tmp;
-		expr->retType = then->retType;
-		expr->pin = 1;
-		expr->flowEnd = nullptr;
-		expr->branch = true;
-		return expr.release();
+		auto n = Count();
+		value.assign(data, pos, n);
+		pos += n;
 	}
 
-	std::any VisitCast(Script::VarType type, const std::any& value) override
+	void Read(std::u8string& value)
 	{
-		auto v = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(value));
-		if (v->retType == type) return v.release();
-		auto expr = std::make_unique<ExprContent>();
-		ExprBuilder builder(*expr);
-		builder.Add(NodeFactory::Cast(graph, *v, type));
-		builder.Combine(*v, 0);
-		expr->retType = type;
-		return expr.release();
+		auto n = Count();
+		value.assign((const char8_t*)data.data() + pos, n);
+		pos += n;
 	}
 
-	std::any VisitMemberAccess(const std::any& value, const std::any& member, std::optional<Script::VarType> type) override
+	template<typename T>
+	void Read(std::vector<T>& values)
 	{
-		auto v = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(value));
-		auto m = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(member));
-		auto expr = std::make_unique<ExprContent>();
-		ExprBuilder builder(*expr);
-		switch (v->retType.type)
-		{
-		case Script::VarType::Entity:
-		{
-			if (m->retType.type != Script::VarType::String) throw std::runtime_error("Member not defined");
-			if (type.has_value()) expr->retType = *type;
-			auto n = builder.Add(NodeFactory::GetCustomVariable(graph, expr->retType));
-			if (m->literal.index() != 0)
-			{
-				n->Set(1, std::get<std::string>(m->literal));
-				expr->extra = LValueContext{ nullptr,v->end,std::get<std::string>(m->literal),v->pin };
-			}
-			else expr->extra = LValueContext{ nullptr,v->end,m->end,v->pin,m->pin };
-			builder.Combine(*v, 0);
-			builder.Combine(*m, 1);
-			break;
-		}
-		case Script::VarType::Vec:
-		{
-			if (m->literal.index() != 3) throw std::runtime_error("Member not defined");
-			auto id = std::get<std::string>(m->literal);
-			builder.Add(graph.CreateNode(Split3DVector));
-			if (id == "x") expr->pin = 0;
-			else if (id == "y") expr->pin = 1;
-			else if (id == "z") expr->pin = 2;
-			else throw std::runtime_error("Member not defined");
-			expr->retType.type = Script::VarType::Float;
-			builder.Combine(*v, 0);
-			break;
-		}
-		case Script::VarType::List:
-		{
-			if (m->retType.type != Script::VarType::Int) throw std::runtime_error("Member not defined");
-			auto n = builder.Add(graph.CreateNode(GetCorrespondingValueFromListInt));
-			builder.Combine(*v, 0);
-			builder.Combine(*m, 1);
-			if (m->literal.index() != 0) n->Set(1, (uint64_t)m->Get<int64_t>());
-			expr->retType = std::any_cast<Script::VarType&>(v->retType.extra);
-			break;
-		}
-		case Script::VarType::Map:
-		case Script::VarType::Tuple:
-			throw std::exception("Unimplemented");
-		default: throw std::runtime_error("Type haven't member access operation");
-		}
-		return expr.release();
+		values.resize(Count());
+		for (auto& v : values) Read(v);
 	}
 
-	std::any VisitConstruct(Script::VarType type, const std::vector<std::any>& args) override
+	template<typename A, typename B>
+	void Read(std::pair<A, B>& value)
 	{
-		throw std::exception("Unimplemented");
+		Read(value.first);
+		Read(value.second);
 	}
 
-	std::any VisitInitializerList(const std::vector<std::any>& values) override
+	void Read(NodeGraph::VarType& value)
 	{
-		auto list = std::make_unique<ExprContent>();
-		std::vector<std::shared_ptr<ExprContent>> eps;
-		for (auto& v : values) eps.emplace_back(std::shared_ptr<ExprContent>(std::any_cast<ExprContent*>(v)));
-		list->extra = std::move(eps);
-		return list.release();
+		std::uint8_t index;
+		Read(index);
+		ReadAlternative(value, index, std::make_index_sequence<std::variant_size_v<NodeGraph::VarType>>{});
 	}
 
-	void VisitReturn(const std::any& value) override
+	void Read(CompositeRef& value)
 	{
-		if (!value.has_value()) return;
-		auto v = std::unique_ptr<ExprContent>(std::any_cast<ExprContent*>(value));
-		if (v->retType != function_header.type) throw std::runtime_error("Return type mismatch");
-		auto r = function_header.ret;
-		auto& n = graph.AddNode(NodeFactory::SetLocalVariable(graph, v->retType));
-		v->Add(graph, layout());
-		AutoLayout(&n);
-		r->Connect(n, 0, 0);
-		v->end->Connect(n, v->pin, 1);
-		if (v->flowStart)
+		Read(value.name);
+		value.graph = nullptr;
+	}
+
+	void Read(StagedValue& value)
+	{
+		std::uint8_t index;
+		Read(index);
+		ReadAlternative(value, index, std::make_index_sequence<std::variant_size_v<StagedValue>>{});
+	}
+
+	void Read(StagedOp& op)
+	{
+		Read(op.kind);
+		Read(op.node);
+		Read(op.args);
+	}
+
+	void Read(StagedBuffer& buffer)
+	{
+		Read(buffer.height);
+		Read(buffer.log);
+	}
+};
+
+// on-disk store of lowered modules, addressed by a hash of source text and compiler version; an entry keeps the source
+// it was lowered from, compared in full on load, and lists the global functions the module calls with their signatures,
+// which must still match before it is replayed, along with the names the module called them by
+class BuildCache
+{
+	std::filesystem::path directory;
+
+public:
+	struct Entry
+	{
+		std::string source;
+		std::vector<std::pair<std::string, std::string>> references;
+		std::vector<std::string> calls;
+		std::vector<StagedBuffer> buffers;
+	};
+
+	struct Hit
+	{
+		Entry entry;
+		std::string code;
+	};
+
+	std::vector<std::string> keys;
+	std::vector<std::string> sources;
+	std::unordered_set<std::size_t> defines;
+	std::unordered_map<std::size_t, Hit> hits;
+	std::size_t replayed = 0;
+
+	explicit BuildCache(std::filesystem::path directory) : directory(std::move(directory)) {}
+
+	const std::filesystem::path& Directory() const { return directory; }
+
+	static std::string Key(const std::string& code)
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+		auto mix = [&](std::string_view text)
+			{
+				for (auto c : text) hash = (hash ^ (unsigned char)c) * 1099511628211ull;
+			};
+		mix(std::format("{}", COMPILER_VERSION));
+		mix({ "\0", 1 });
+		mix(code);
+		return std::format("{:016x}", hash);
+	}
+
+	std::optional<Entry> Load(const std::string& key, const std::string& code) const
+	{
+		std::ifstream file(directory / (key + ".gisc"), std::ios::binary);
+		if (!file) return std::nullopt;
+		std::string data{ std::istreambuf_iterator<char>(file), {} };
+		try
 		{
-			prev->Connect(*v->flowStart, flow, 0, true);
-			prev = v->flowEnd;
+			CacheReader reader(data);
+			std::array<char, 4> magic;
+			std::uint32_t format, version;
+			reader.Read(magic);
+			reader.Read(format);
+			reader.Read(version);
+			if (magic != std::array{ 'G', 'I', 'S', 'C' } || format != CACHE_FORMAT || version != COMPILER_VERSION) return std::nullopt;
+			Entry entry;
+			reader.Read(entry.source);
+			if (entry.source != code) return std::nullopt;
+			reader.Read(entry.references);
+			reader.Read(entry.calls);
+			reader.Read(entry.buffers);
+			if (!reader.End()) return std::nullopt;
+			return entry;
 		}
-		prev->Connect(n);
-		prev = &n;
+		catch (const std::runtime_error&)
+		{
+			return std::nullopt;
+		}
+	}
+
+	// best effort: a cache that cannot be written only costs the next build its reuse
+	void Store(const std::string& key, const Entry& entry) const
+	{
+		CacheWriter writer;
+		writer.Write(std::array{ 'G', 'I', 'S', 'C' });
+		writer.Write(CACHE_FORMAT);
+		writer.Write(COMPILER_VERSION);
+		writer.Write(entry.source);
+		writer.Write(entry.references);
+		writer.Write(entry.calls);
+		writer.Write(entry.buffers);
+		std::error_code ec;
+		std::filesystem::create_directories(directory, ec);
+		auto path = directory / (key + ".gisc");
+		auto temp = path;
+		temp += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+		{
+			std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+			if (!file) return;
+			file.write(writer.Data().data(), (std::streamsize)writer.Data().size());
+			if (!file) return;
+		}
+		std::filesystem::rename(temp, path, ec);
+		if (ec) std::filesystem::remove(temp, ec);
 	}
 };
 
+template<typename D>
+static std::string Signature(const D& declaration)
+{
+	std::string text = "(";
+	for (auto& p : declaration.parameters) text += p.Key() + ",";
+	return text + ")" + (declaration.ret ? declaration.ret->Key() : "void");
+}
+
+static bool ContainsWord(const std::string& code, const std::string& word)
+{
+	auto identifier = [](char c) { return (unsigned char)c >= 0x80 || c == '_' || std::isalnum((unsigned char)c); };
+	for (auto pos = code.find(word); pos != std::string::npos; pos = code.find(word, pos + 1))
+	{
+		if (pos > 0 && identifier(code[pos - 1])) continue;
+		if (auto end = pos + word.size(); end < code.size() && identifier(code[end])) continue;
+		return true;
+	}
+	return false;
+}
+
 void Compiler::AddGlobalFunction(const std::string& name, std::unique_ptr<FunctionNode> func)
 {
-	auto& [graph, ast] = symbol_modules.emplace_back(CreateGraph(name, GraphType::Composite), std::move(func));
-	project->Define(*graph);
+	symbol_modules.emplace_back(create_graph(name, GraphType::Composite), std::move(func));
+}
+
+Compiler::Compiler(std::unique_ptr<IProject> project, GraphFactory create_graph) : project(std::move(project)), create_graph(std::move(create_graph))
+{
 }
 
-Compiler::Compiler(std::unique_ptr<IProject> project) : project(std::move(project))
+Compiler::~Compiler() = default;
+
+void Compiler::EnableCache(const std::filesystem::path& directory)
+{
+	if (!modules.empty()) throw std::runtime_error("The build cache must be enabled before modules are added");
+	cache = std::make_unique<BuildCache>(directory);
+}
+
+std::size_t Compiler::Cached() const
 {
+	return cache ? cache->replayed : 0;
 }
 
 void Compiler::AddModule(const std::string& name, const std::string& code)
 {
-	auto& [graph, ast] = modules.emplace_back(CreateGraph(name, GraphType::Entity), Parse(code));
+	Trace::Span span("AddModule", name);
+	Memory::Scope memory("AddModule", name);
+	module_names.push_back(name);
+	if (cache)
+	{
+		auto& key = cache->keys.emplace_back(BuildCache::Key(code));
+		cache->sources.push_back(code);
+		if (auto entry = cache->Load(key, code))
+		{
+			auto& [graph, ast] = modules.emplace_back(create_graph(name, GraphType::Entity), nullptr);
+			project->Define(*graph);
+			cache->hits.emplace(modules.size() - 1, BuildCache::Hit{ std::move(*entry), code });
+			return;
+		}
+	}
+	auto& [graph, ast] = modules.emplace_back(create_graph(name, GraphType::Entity), Parse(code));
 	project->Define(*graph);
-	for (auto gfs = ((RootNode*)ast.get())->GlobalFunctions(); auto& f : gfs)
+	auto gfs = ((RootNode*)ast.get())->GlobalFunctions();
+	if (cache && !gfs.empty()) cache->defines.insert(modules.size() - 1);
+	for (auto& f : gfs)
+	{
+		auto fn = f->Name();
+		function_modules.emplace(fn, name);
+		AddGlobalFunction("GIScript#" + fn, std::move(f));
+	}
+}
+
+static constexpr std::size_t OUTLINE_MIN_COST = 16;
+
+// runs body(0..count-1) on a pool of workers; the lowest failing index wins so errors do not depend on scheduling
+static void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& body)
+{
+	if (count == 0) return;
+	std::vector<std::exception_ptr> errors(count);
+	std::atomic_size_t next = 0;
+	auto worker = [&]
+		{
+			for (std::size_t i; (i = next++) < count;)
+			{
+				try { body(i); }
+				catch (...) { errors[i] = std::current_exception(); }
+			}
+		};
+	{
+		std::vector<std::jthread> workers;
+		for (auto n = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), count); --n;) workers.emplace_back(worker);
+		worker();
+	}
+	for (auto& e : errors) if (e) std::rethrow_exception(e);
+}
+
+bool Compiler::Outline(OutlinedStatement& statement, const std::vector<Script::VarType>& types)
+{
+	auto f = statement.Extract(types);
+	auto [it, inserted] = composites.try_emplace(f->Canonical(), statement.Name());
+	if (!inserted)
 	{
-		auto name = f->Name();
-		AddGlobalFunction("GIScript#" + name, std::move(f));
+		statement.Restore(*f);
+		GlobalFunctions.map[statement.Name()] = GlobalFunctions.map.at(it->second);
+		outline_calls[statement.Name()] = { it->second };
+		return true;
 	}
+	auto graph = create_graph("GIScript#" + statement.Name(), GraphType::Composite);
+	try
+	{
+		NodeGenerator g(*graph, *this);
+		g.scope.enter();
+		g.VisitGlobalFunction(*f);
+		f->VisitBody(g);
+		g.EndGlobalFunction();
+		simplified += g.simplified;
+		outline_calls[statement.Name()] = std::move(g.called);
+	}
+	catch (const std::exception&)
+	{
+		// the sequence does not lower as a composite body, so every occurrence stays inline
+		GlobalFunctions.map.erase(statement.Name());
+		composites.erase(it);
+		rejected_outlines.insert(statement.Name());
+		statement.Restore(*f);
+		return false;
+	}
+	project->Define(*graph);
+	symbol_modules.emplace_back(std::move(graph), std::move(f));
+	return true;
 }
 
 void Compiler::Compile()
 {
-	std::vector<std::function<void()>> actions;
+	Trace::Span span("Compile");
+	Memory::Scope memory("Codegen");
+	std::vector<ASTNode*> roots;
+	std::vector<std::size_t> parsed;
+	for (std::size_t i = 0; i < modules.size(); i++)
+	{
+		if (!modules[i].ast) continue;
+		roots.push_back(modules[i].ast.get());
+		parsed.push_back(i);
+	}
+	std::vector<std::size_t> outlines(modules.size());
+	// cached modules have no AST to outline against, so a cached build would emit other graphs than a clean one
+	if (!cache) for (std::size_t i = 0; auto n : Script::Outline(roots, OUTLINE_MIN_COST)) outlines[parsed[i++]] = n;
+	// global functions whose bodies lower identically share the first one's composite
+	std::unordered_map<std::string, std::string> aliases;
+	std::unordered_set<std::string> names;
+	std::erase_if(symbol_modules, [&](const Module& m)
+		{
+			auto& f = *(FunctionNode*)m.ast.get();
+			if (!names.insert(f.Name()).second) return false;
+			auto [it, inserted] = composites.try_emplace(f.Canonical(), f.Name());
+			if (inserted) return false;
+			aliases.emplace(f.Name(), it->second);
+			return true;
+		});
+	for (auto& [graph, ast] : symbol_modules) project->Define(*graph);
+	std::vector<std::unique_ptr<NodeGenerator>> generators;
 	for (auto& [graph, ast] : symbol_modules)
 	{
-		auto& f = *(FunctionNode*)ast.get();
-		auto g = std::make_shared<NodeGenerator>(*graph, *this);
-		g->scope.enter();
-		g->VisitGlobalFunction(f.Name(), f.Ret(), f.Parameters());
-		actions.emplace_back([&f, g, graph = graph.get()] mutable
+		Trace::Span header("GlobalFunctionHeader", ((FunctionNode*)ast.get())->Name());
+		auto& g = *generators.emplace_back(std::make_unique<NodeGenerator>(*graph, *this));
+		g.scope.enter();
+		g.VisitGlobalFunction(*(FunctionNode*)ast.get());
+	}
+	for (auto& [alias, name] : aliases)
+	{
+		if (GlobalFunctions.map.contains(alias)) throw std::runtime_error(std::format("function '{}' is already defined", alias));
+		GlobalFunctions.map[alias] = GlobalFunctions.map.at(name);
+	}
+	// a cached module is replayed while every global it calls keeps its signature and no other global shadows one of its names
+	std::vector<std::size_t> replays;
+	if (cache)
+	{
+		Trace::Span validate("ValidateCache");
+		for (auto& [i, hit] : cache->hits)
+		{
+			auto valid = std::ranges::all_of(hit.entry.references, [&](const auto& r)
+				{
+					auto it = GlobalFunctions.map.find(r.first);
+					return it != GlobalFunctions.map.end() && Signature(it->second) == r.second;
+				});
+			for (auto& [name, f] : GlobalFunctions.map)
+			{
+				if (!valid) break;
+				valid = std::ranges::contains(hit.entry.references, name, &std::pair<std::string, std::string>::first) || !ContainsWord(hit.code, name);
+			}
+			if (!valid)
+			{
+				modules[i].ast = Parse(hit.code);
+				continue;
+			}
+			for (auto& b : hit.entry.buffers)
+			{
+				for (auto& op : b.log) if (op.kind == StagedOp::CreateComposite) for (auto& a : op.args) if (auto c = std::get_if<CompositeRef>(&a)) c->graph = GlobalFunctions.map.at(c->name).graph;
+			}
+			replays.push_back(i);
+		}
+		std::ranges::sort(replays);
+		for (auto i : replays) cache->hits.at(i).code.clear();
+	}
+	// modules with outlined sequences define composites lazily, so they run afterwards in module order;
+	// the others are split per declaration so a single large module still spreads over the workers
+	std::vector<std::unique_ptr<ModuleStage>> stages;
+	std::vector<std::size_t> staged, dependent;
+	std::vector<std::pair<ModuleStage*, std::size_t>> tasks;
+	for (std::size_t i = 0; i < modules.size(); i++)
+	{
+		if (!modules[i].ast) continue;
+		if (outlines[i])
+		{
+			dependent.push_back(i);
+			continue;
+		}
+		Trace::Span stage_span("StageModule", module_names[i]);
+		Memory::Scope stage_memory("Codegen", module_names[i]);
+		auto& stage = *stages.emplace_back(std::make_unique<ModuleStage>(*modules[i].graph, module_names[i], *(RootNode*)modules[i].ast.get(), *this));
+		staged.push_back(i);
+		for (std::size_t t = 0; t < stage.Size(); t++) tasks.emplace_back(&stage, t);
+	}
+	// from here on GlobalFunctions and the registries are only read, and every generator owns its graph or staging buffer;
+	// the pins a global function body still sets on its composite are written and read under composite_pins
+	ParallelFor(generators.size() + tasks.size(), [&](std::size_t i)
+		{
+			if (i >= generators.size())
+			{
+				auto [stage, t] = tasks[i - generators.size()];
+				stage->Run(t);
+				return;
+			}
+			auto name = ((FunctionNode*)symbol_modules[i].ast.get())->Name();
+			Trace::Span function("GlobalFunction", name);
+			Memory::Scope function_memory("Codegen", function_modules.at(name));
+			((FunctionNode*)symbol_modules[i].ast.get())->VisitBody(*generators[i]);
+			generators[i]->EndGlobalFunction();
+		});
+	std::map<std::string, std::set<std::string>> calls;
+	for (auto& name : module_names) calls[name];
+	for (std::size_t i = 0; i < generators.size(); i++)
+	{
+		simplified += generators[i]->simplified;
+		calls[function_modules.at(((FunctionNode*)symbol_modules[i].ast.get())->Name())].insert_range(generators[i]->called);
+	}
+	for (auto i : replays) calls[module_names[i]].insert_range(cache->hits.at(i).entry.calls);
+	std::unordered_map<const IGraph*, std::string> composite_names;
+	for (auto& [name, f] : GlobalFunctions.map)
+	{
+		auto [it, inserted] = composite_names.try_emplace(f.graph, name);
+		if (!inserted && name < it->second) it->second = name;
+	}
+	std::vector<std::size_t> reduced(stages.size());
+	ParallelFor(stages.size() + replays.size(), [&](std::size_t i)
+		{
+			if (i >= stages.size())
+			{
+				auto m = replays[i - stages.size()];
+				Trace::Span replay("Replay", module_names[m]);
+				Memory::Scope replay_memory("Codegen", module_names[m]);
+				Replayer replayer(*modules[m].graph);
+				for (auto& b : cache->hits.at(m).entry.buffers) replayer.Run(b);
+				return;
+			}
+			Trace::Span merge("Merge", module_names[staged[i]]);
+			Memory::Scope merge_memory("Codegen", module_names[staged[i]]);
+			reduced[i] = stages[i]->Merge();
+			// modules that define global functions are left out, their composites are not part of the entry
+			if (!cache || cache->defines.contains(staged[i])) return;
+			BuildCache::Entry entry{ cache->sources[staged[i]], {}, std::ranges::to<std::vector>(stages[i]->Called()), stages[i]->Buffers() };
+			for (auto& b : entry.buffers)
 			{
-				f.VisitBody(*g);
-				g->scope.exit();
-				auto ex = g->prev;
-				if (g->flow != 0)
+				for (auto& op : b.log)
 				{
-					ex = &graph->AddNode(NodeId::DoubleBranch);
-					ex->Set(0, Enum{ 1 }, ServerVarType::Boolean);
-					ex->SetComment("Dummy ExitPoint");
-					g->AutoLayout(ex);
+					if (op.kind != StagedOp::CreateComposite) continue;
+					for (auto& a : op.args)
+					{
+						auto c = std::get_if<CompositeRef>(&a);
+						if (!c) continue;
+						c->name = composite_names.at(c->graph);
+						if (!std::ranges::contains(entry.references, c->name, &std::pair<std::string, std::string>::first)) entry.references.emplace_back(c->name, Signature(GlobalFunctions.map.at(c->name)));
+					}
 				}
-				graph->SetCompositePin(*ex, PinType::Outflow, 0, 0);
-			});
-	}
-	for (auto& a : actions) a();
-	for (auto& [graph, ast] : modules)
+			}
+			cache->Store(cache->keys[staged[i]], entry);
+		});
+	for (auto n : reduced) simplified += n;
+	for (std::size_t i = 0; i < stages.size(); i++) calls[module_names[staged[i]]].insert_range(stages[i]->Called());
+	if (cache) cache->replayed = replays.size();
+	stages.clear();
+	for (auto i : dependent)
 	{
+		Trace::Span module("Module", module_names[i]);
+		Memory::Scope module_memory("Codegen", module_names[i]);
+		auto& [graph, ast] = modules[i];
 		NodeGenerator g(*graph, *this);
 		ast->Visit(g);
+		simplified += g.simplified;
+		calls[module_names[i]].insert_range(g.called);
+	}
+	Trace::Span resolve("Dependencies");
+	dependencies = {};
+	for (auto& [name, module] : function_modules)
+	{
+		if (auto it = GlobalFunctions.map.find(name); it != GlobalFunctions.map.end()) dependencies.functions.emplace(name, DependencyGraph::Function{ module, Signature(it->second) });
+	}
+	// outlined composites belong to no module, so their callers depend on whatever the outlined code calls
+	for (auto& [module, names] : calls)
+	{
+		auto& resolved = dependencies.calls[module];
+		std::vector pending(names.begin(), names.end());
+		std::unordered_set<std::string> seen;
+		while (!pending.empty())
+		{
+			auto name = std::move(pending.back());
+			pending.pop_back();
+			if (!seen.insert(name).second) continue;
+			if (auto it = outline_calls.find(name); it != outline_calls.end()) pending.append_range(it->second);
+			else if (dependencies.functions.contains(name)) resolved.insert(name);
+		}
+	}
+	if (cache) dependencies.Save(cache->Directory() / "dependencies.tsv");
+}
+
+std::vector<std::string> DependencyGraph::Callers(const std::string& function) const
+{
+	std::vector<std::string> callers;
+	for (auto& [module, names] : calls) if (names.contains(function)) callers.push_back(module);
+	return callers;
+}
+
+std::vector<std::string> DependencyGraph::Dependents(const std::string& module) const
+{
+	std::vector<std::string> dependents;
+	for (auto& [caller, names] : calls)
+	{
+		if (std::ranges::any_of(names, [&](const std::string& n) { return functions.at(n).module == module; })) dependents.push_back(caller);
+	}
+	return dependents;
+}
+
+std::vector<std::string> DependencyGraph::Invalidated(const DependencyGraph& current) const
+{
+	std::vector<std::string> invalidated;
+	for (auto& [module, names] : calls)
+	{
+		auto changed = std::ranges::any_of(names, [&](const std::string& n)
+			{
+				auto it = current.functions.find(n);
+				return it == current.functions.end() || it->second.signature != functions.at(n).signature;
+			});
+		if (changed) invalidated.push_back(module);
+	}
+	return invalidated;
+}
+
+// one tab separated record per line: "function <name> <module> <signature>" or "call <module> <function>";
+// a module that calls nothing is listed as "module <name>"
+void DependencyGraph::Save(const std::filesystem::path& path) const
+{
+	std::error_code ec;
+	std::filesystem::create_directories(path.parent_path(), ec);
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) throw std::runtime_error("Cannot write dependency graph");
+	for (auto& [name, f] : functions) file << std::format("function\t{}\t{}\t{}\n", name, f.module, f.signature);
+	for (auto& [module, names] : calls)
+	{
+		if (names.empty()) file << std::format("module\t{}\n", module);
+		for (auto& n : names) file << std::format("call\t{}\t{}\n", module, n);
+	}
+}
+
+DependencyGraph DependencyGraph::Load(const std::filesystem::path& path)
+{
+	DependencyGraph graph;
+	std::ifstream file(path, std::ios::binary);
+	if (!file) return graph;
+	for (std::string line; std::getline(file, line);)
+	{
+		if (line.empty()) continue;
+		std::vector<std::string> fields;
+		for (auto f : std::views::split(line, '\t')) fields.emplace_back(f.begin(), f.end());
+		if (fields[0] == "function" && fields.size() == 4) graph.functions[fields[1]] = { fields[2], fields[3] };
+		else if (fields[0] == "call" && fields.size() == 3) graph.calls[fields[1]].insert(fields[2]);
+		else if (fields[0] == "module" && fields.size() == 2) graph.calls[fields[1]];
+		else throw std::runtime_error(std::format("Malformed dependency graph line: {}", line));
 	}
+	for (auto& [module, names] : graph.calls)
+	{
+		for (auto& n : names) if (!graph.functions.contains(n)) throw std::runtime_error(std::format("Dependency graph references unknown function '{}'", n));
+	}
+	return graph;
 }
 
 void Compiler::Write() const
 {
+	Trace::Span span("Write");
+	Memory::Scope memory("Write");
 	for (const auto& [graph, ast] : symbol_modules) project->Add(*graph);
-	for (const auto& [graph, ast] : modules) project->Add(*graph);
+	for (std::size_t i = 0; i < modules.size(); i++)
+	{
+		Memory::Scope module("Write", module_names[i]);
+		project->Add(*modules[i].graph);
+	}
 }
@@ -10,21 +10,59 @@ using namespace Script;
 using namespace NodeGraph;
 
 class NodeGenerator;
+class BuildCache;
 
 export namespace Editor::Tools
 {
+	// creates the graphs modules and global functions are lowered into, so the compiler can run on any IGraph backend
+	using GraphFactory = std::function<std::unique_ptr<IGraph>(const std::string& name, GraphType type)>;
+
 	struct Module
 	{
 		std::unique_ptr<IGraph> graph;
 		std::unique_ptr<ASTNode> ast;
 	};
 
+	// which modules call which global functions and where those are defined, so build tooling can tell
+	// what a change invalidates: a new signature affects the callers, a new body affects nobody
+	struct DependencyGraph
+	{
+		struct Function
+		{
+			std::string module;
+			std::string signature;
+		};
+
+		std::map<std::string, Function> functions;
+		std::map<std::string, std::set<std::string>> calls;
+
+		std::vector<std::string> Callers(const std::string& function) const;
+		// modules calling a global function defined by the module
+		std::vector<std::string> Dependents(const std::string& module) const;
+		// modules of this graph that call a function which is gone or has another signature in the current graph
+		std::vector<std::string> Invalidated(const DependencyGraph& current) const;
+		void Save(const std::filesystem::path& path) const;
+		static DependencyGraph Load(const std::filesystem::path& path);
+	};
+
 	class Compiler
 	{
 		friend NodeGenerator;
 		std::unique_ptr<IProject> project;
+		GraphFactory create_graph;
 		std::vector<Module> modules;
 		std::vector<Module> symbol_modules;
+		std::size_t simplified = 0;
+		std::size_t outlined = 0;
+		std::unordered_set<std::string> rejected_outlines;
+		std::unordered_map<std::string, std::string> composites;
+		// guards the pin tables of global function composites, which callers on other workers read while the body still sets them
+		std::mutex composite_pins;
+		std::unique_ptr<BuildCache> cache;
+		std::vector<std::string> module_names;
+		std::unordered_map<std::string, std::string> function_modules;
+		std::unordered_map<std::string, std::set<std::string>> outline_calls;
+		DependencyGraph dependencies;
 
 		struct
 		{
@@ -39,11 +77,19 @@ export namespace Editor::Tools
 		} GlobalFunctions;
 
 		void AddGlobalFunction(const std::string& name, std::unique_ptr<FunctionNode> func);
+		bool Outline(OutlinedStatement& statement, const std::vector<Script::VarType>& types);
 	public:
-		explicit Compiler(std::unique_ptr<IProject> project);
+		Compiler(std::unique_ptr<IProject> project, GraphFactory create_graph);
+		~Compiler();
+		// reuses lowered modules from earlier builds and turns outlining off; must be called before any module is added
+		void EnableCache(const std::filesystem::path& directory);
 		void AddModule(const std::string& name, const std::string& code);
 		void Compile();
 		void Write() const;
 		std::unique_ptr<IProject> Release() { return std::move(project); }
+		std::size_t Simplified() const { return simplified; }
+		std::size_t Outlined() const { return outlined; }
+		std::size_t Cached() const;
+		const DependencyGraph& Dependencies() const { return dependencies; }
 	};
 }
@@ -7,6 +7,8 @@ module app.window;
 import util;
 import compiler;
 import image;
+import trace;
+import memory_usage;
 
 using namespace Editor;
 using namespace UI;
@@ -19,6 +21,38 @@ static auto LoadScript(const std::filesystem::path& path)
 	return code;
 }
 
+// GISC_TRACE names a file to record every compile as a Chrome trace, GISC_MEMORY one for its allocations per phase,
+// GISC_CACHE the directory to keep lowered modules in between compiles
+static std::optional<std::filesystem::path> PathFromEnvironment(const wchar_t* name)
+{
+	wchar_t path[MAX_PATH];
+	auto length = GetEnvironmentVariableW(name, path, MAX_PATH);
+	if (length == 0 || length >= MAX_PATH) return std::nullopt;
+	return std::filesystem::path(path);
+}
+
+// ends the recordings when a compile leaves early, so a failed one does not keep counting what the error dialog allocates
+class Recordings
+{
+	bool trace, memory;
+
+public:
+	Recordings(bool trace, bool memory) : trace(trace), memory(memory)
+	{
+		if (trace) Ugc::Trace::Start();
+		if (memory) Ugc::Memory::Start();
+	}
+
+	Recordings(const Recordings&) = delete;
+	Recordings& operator=(const Recordings&) = delete;
+
+	~Recordings()
+	{
+		if (trace) Ugc::Trace::Stop();
+		if (memory) Ugc::Memory::Stop();
+	}
+};
+
 MainWindow::MainWindow() : Window(L"GIScriptEditor")
 {
 	{
@@ -116,8 +150,12 @@ MainWindow::MainWindow() : Window(L"GIScriptEditor")
 				{
 					if (!std::filesystem::exists(pp)) throw std::runtime_error("Project file not exists");
 					if (!(std::filesystem::exists(sd) && std::filesystem::is_directory(sd))) throw std::runtime_error("Script directory not exists");
+					auto trace = PathFromEnvironment(L"GISC_TRACE");
+					auto memory = PathFromEnvironment(L"GISC_MEMORY");
+					Recordings recordings(trace.has_value(), memory.has_value());
 					auto start = std::chrono::high_resolution_clock::now();
-					Tools::Compiler compiler(Ugc::NodeGraph::LoadProject(pp));
+					Tools::Compiler compiler(Ugc::NodeGraph::LoadProject(pp), Ugc::NodeGraph::CreateGraph);
+					if (auto cache = PathFromEnvironment(L"GISC_CACHE")) compiler.EnableCache(*cache);
 					int count = 0;
 					for (auto& entry : std::filesystem::directory_iterator(sd))
 					{
@@ -128,10 +166,26 @@ MainWindow::MainWindow() : Window(L"GIScriptEditor")
 					}
 					compiler.Compile();
 					compiler.Write();
-					compiler.Release()->Save(pp);
+					{
+						Ugc::Trace::Span span("Save");
+						Ugc::Memory::Scope scope("Save");
+						compiler.Release()->Save(pp);
+					}
 					auto end = std::chrono::high_resolution_clock::now();
+					if (trace)
+					{
+						Ugc::Trace::Stop();
+						Ugc::Trace::Save(*trace);
+					}
+					if (memory)
+					{
+						Ugc::Memory::Stop();
+						Ugc::Memory::Save(*memory);
+					}
 					auto duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-					co_await Dialog(L"提示", std::format(L"写入完成。共编译 {} 个文件。耗时 {}", count, duration_ms), MB_ICONINFORMATION);
+					auto message = std::format(L"写入完成。共编译 {} 个文件。耗时 {}。复用缓存 {} 个文件，化简消除 {} 个节点，提取 {} 处重复代码", count, duration_ms, compiler.Cached(), compiler.Simplified(), compiler.Outlined());
+					if (memory) message += std::format(L"。内存峰值 {:.1f} MiB，共分配 {} 次", Ugc::Memory::Peak() / (1024.0 * 1024.0), Ugc::Memory::Total().allocations);
+					co_await Dialog(L"提示", message, MB_ICONINFORMATION);
 					lock = false;
 					co_return;
 				}
@@ -0,0 +1,560 @@
+module;
+#include <GINodeGraph.h>
+module memory_graph;
+
+using namespace Editor::Tools;
+
+using LiteralKind = MemoryGraphData::LiteralKind;
+
+enum class ValueTag : std::uint8_t
+{
+	Int,
+	Unsigned,
+	UInt64,
+	Int64,
+	Float,
+	Double,
+	Bool,
+	String,
+	Vec,
+	Enum,
+	GUID,
+	Type,
+	IntegerList,
+	FloatList,
+	StringList,
+	VectorList,
+	IdList
+};
+
+class PayloadWriter
+{
+	std::vector<std::byte>& out;
+
+	template<typename T>
+	void Raw(const T& value)
+	{
+		auto p = reinterpret_cast<const std::byte*>(&value);
+		out.insert(out.end(), p, p + sizeof(T));
+	}
+
+	void Text(std::string_view text)
+	{
+		Raw((std::uint32_t)text.size());
+		auto p = reinterpret_cast<const std::byte*>(text.data());
+		out.insert(out.end(), p, p + text.size());
+	}
+
+	template<typename T>
+	void List(ValueTag tag, const void* ptr, int length)
+	{
+		Raw(tag);
+		Raw((std::uint32_t)length);
+		for (auto& v : std::span((const T*)ptr, length))
+		{
+			if constexpr (std::is_same_v<T, std::string>) Text(v);
+			else Raw(v);
+		}
+	}
+
+public:
+	explicit PayloadWriter(std::vector<std::byte>& out) : out(out) {}
+
+	void Put(int v) { Raw(ValueTag::Int); Raw(v); }
+	void Put(unsigned v) { Raw(ValueTag::Unsigned); Raw(v); }
+	void Put(unsigned long long v) { Raw(ValueTag::UInt64); Raw(v); }
+	void Put(long long v) { Raw(ValueTag::Int64); Raw(v); }
+	void Put(float v) { Raw(ValueTag::Float); Raw(v); }
+	void Put(double v) { Raw(ValueTag::Double); Raw(v); }
+	void Put(bool v) { Raw(ValueTag::Bool); Raw(v); }
+	void Put(std::string_view v) { Raw(ValueTag::String); Text(v); }
+	void Put(const Vec& v) { Raw(ValueTag::Vec); Raw(v.x); Raw(v.y); Raw(v.z); }
+	void Put(const Enum& v) { Raw(ValueTag::Enum); Raw(v.val); }
+	void Put(const GUID& v) { Raw(ValueTag::GUID); Raw(v.val); }
+
+	void Put(const VarType& v)
+	{
+		Raw(ValueTag::Type);
+		Raw((std::uint8_t)v.index());
+		Raw(std::visit([](auto t) { return (std::int32_t)t; }, v));
+	}
+
+	// list element types follow the same server types the node templates use, everything else is an id list
+	void PutList(const void* ptr, int length, const VarType& type)
+	{
+		switch (std::holds_alternative<ServerVarType>(type) ? std::get<ServerVarType>(type) : ServerVarType::Unknown)
+		{
+		case ServerVarType::IntegerList: List<unsigned long long>(ValueTag::IntegerList, ptr, length); break;
+		case ServerVarType::FloatList: List<float>(ValueTag::FloatList, ptr, length); break;
+		case ServerVarType::StringList: List<std::string>(ValueTag::StringList, ptr, length); break;
+		case ServerVarType::VectorList: List<Vec>(ValueTag::VectorList, ptr, length); break;
+		default: List<unsigned>(ValueTag::IdList, ptr, length); break;
+		}
+		Put(type);
+	}
+};
+
+static std::string Quote(std::string_view text)
+{
+	std::string quoted = "\"";
+	for (auto c : text)
+	{
+		if (c == '"' || c == '\\') quoted += '\\';
+		if (c == '\n') quoted += "\\n";
+		else quoted += c;
+	}
+	return quoted + "\"";
+}
+
+class PayloadReader
+{
+	std::span<const std::byte> in;
+	std::size_t pos = 0;
+
+	template<typename T>
+	T Raw()
+	{
+		if (pos + sizeof(T) > in.size()) throw std::runtime_error("Literal payload is truncated");
+		T value;
+		std::memcpy(&value, in.data() + pos, sizeof(T));
+		pos += sizeof(T);
+		return value;
+	}
+
+	std::string Text()
+	{
+		auto size = Raw<std::uint32_t>();
+		if (pos + size > in.size()) throw std::runtime_error("Literal payload is truncated");
+		std::string text(reinterpret_cast<const char*>(in.data() + pos), size);
+		pos += size;
+		return text;
+	}
+
+	std::string Vector()
+	{
+		auto x = Raw<float>(), y = Raw<float>(), z = Raw<float>();
+		return std::format("({}, {}, {})", x, y, z);
+	}
+
+	template<typename F>
+	std::string List(F&& element)
+	{
+		auto size = Raw<std::uint32_t>();
+		std::string text = "[";
+		for (std::uint32_t i = 0; i < size; i++)
+		{
+			if (i) text += ", ";
+			text += element();
+		}
+		return text + "]";
+	}
+
+public:
+	explicit PayloadReader(std::span<const std::byte> in) : in(in) {}
+
+	bool End() const { return pos == in.size(); }
+
+	std::string Next()
+	{
+		switch (Raw<ValueTag>())
+		{
+		case ValueTag::Int: return std::format("{}i", Raw<int>());
+		case ValueTag::Unsigned: return std::format("{}u", Raw<unsigned>());
+		case ValueTag::UInt64: return std::format("{}ull", Raw<unsigned long long>());
+		case ValueTag::Int64: return std::format("{}ll", Raw<long long>());
+		case ValueTag::Float: return std::format("{}f", Raw<float>());
+		case ValueTag::Double: return std::format("{}d", Raw<double>());
+		case ValueTag::Bool: return Raw<bool>() ? "true" : "false";
+		case ValueTag::String: return Quote(Text());
+		case ValueTag::Vec: return Vector();
+		case ValueTag::Enum: return std::format("enum {}", Raw<unsigned>());
+		case ValueTag::GUID: return std::format("guid {}", Raw<unsigned>());
+		case ValueTag::Type:
+		{
+			auto side = Raw<std::uint8_t>();
+			return std::format("{}:{}", side ? "client" : "server", Raw<std::int32_t>());
+		}
+		case ValueTag::IntegerList: return List([&] { return std::format("{}", Raw<unsigned long long>()); });
+		case ValueTag::FloatList: return List([&] { return std::format("{}", Raw<float>()); });
+		case ValueTag::StringList: return List([&] { return Quote(Text()); });
+		case ValueTag::VectorList: return List([&] { return Vector(); });
+		case ValueTag::IdList: return List([&] { return std::format("{}", Raw<unsigned>()); });
+		}
+		throw std::runtime_error("Unknown literal payload tag");
+	}
+};
+
+class MemoryNode final : public INode
+{
+	friend MemoryGraph;
+	MemoryGraph* graph;
+	std::uint32_t slot;
+
+	template<typename... T>
+	void Write(LiteralKind kind, int pin, std::uint32_t index, bool out, const T&... values)
+	{
+		auto offset = graph->data.payload.size();
+		PayloadWriter writer(graph->data.payload);
+		(writer.Put(values), ...);
+		graph->CommitLiteral({ slot, pin, index, kind, out }, offset);
+	}
+
+	void WriteList(LiteralKind kind, int pin, std::uint32_t index, const void* ptr, int length, const VarType& type)
+	{
+		auto offset = graph->data.payload.size();
+		PayloadWriter(graph->data.payload).PutList(ptr, length, type);
+		graph->CommitLiteral({ slot, pin, index, kind, false }, offset);
+	}
+
+	static MemoryNode& Of(INode& node)
+	{
+		auto n = dynamic_cast<MemoryNode*>(&node);
+		if (!n) throw std::runtime_error("Node does not belong to an in-memory graph");
+		return *n;
+	}
+
+	MemoryGraphData::Node& Record() const { return graph->data.nodes[slot]; }
+
+public:
+	static constexpr auto None = MemoryGraphData::None;
+
+	MemoryNode(MemoryGraph* graph, std::uint32_t slot) : graph(graph), slot(slot) {}
+
+	// a node that was created but never added is dropped with its handle
+	~MemoryNode() override
+	{
+		if (!Record().added) Record().alive = false;
+	}
+
+	unsigned Id() const override { return slot + 1; }
+
+	void Change(NodeId id) override
+	{
+		Record().id = id;
+		Record().composite = None;
+	}
+
+	void Connect(INode& target, int from, int to, bool flow) override
+	{
+		auto& t = Of(target);
+		if (t.graph != graph) throw std::runtime_error("Cannot connect nodes of different graphs");
+		graph->data.edges.emplace_back(slot, t.slot, from, to, flow);
+	}
+
+	void Connect(INode& target) override { Connect(target, 0, 0, true); }
+	void Set(int pin, unsigned long long value) override { Write(LiteralKind::Set, pin, None, false, value); }
+	void Set(int pin, float value) override { Write(LiteralKind::Set, pin, None, false, value); }
+	void Set(int pin, const std::string& value) override { Write(LiteralKind::Set, pin, None, false, std::string_view(value)); }
+	void Set(int pin, const char8_t* value) override { Write(LiteralKind::Set, pin, None, false, std::string_view(reinterpret_cast<const char*>(value))); }
+	void Set(int pin, int value) override { Write(LiteralKind::Set, pin, None, false, value); }
+	void Set(int pin, unsigned value) override { Write(LiteralKind::Set, pin, None, false, value); }
+	void Set(int pin, double value) override { Write(LiteralKind::Set, pin, None, false, value); }
+	void Set(int pin, const Vec& value) override { Write(LiteralKind::Set, pin, None, false, value); }
+	void Set(int pin, const Enum& value, VarType type) override { Write(LiteralKind::SetTyped, pin, None, false, value, type); }
+	void Set(int pin, const GUID& value, VarType type) override { Write(LiteralKind::SetTyped, pin, None, false, value, type); }
+	void Set(int pin, const void* ptr, int length, VarType type) override { WriteList(LiteralKind::SetList, pin, None, ptr, length, type); }
+	void Set(int pin, const void* ptr, int length, VarType type, unsigned index) override { WriteList(LiteralKind::SetListAt, pin, index, ptr, length, type); }
+	void Set(int pin, unsigned index, unsigned long long value) override { Write(LiteralKind::SetAt, pin, index, false, value); }
+	void Set(int pin, unsigned index, float value) override { Write(LiteralKind::SetAt, pin, index, false, value); }
+	void Set(int pin, unsigned index, const std::string& value) override { Write(LiteralKind::SetAt, pin, index, false, std::string_view(value)); }
+	void Set(int pin, unsigned index, const Vec& value) override { Write(LiteralKind::SetAt, pin, index, false, value); }
+	void Set(int pin, unsigned index, const Enum& value, VarType type) override { Write(LiteralKind::SetTypedAt, pin, index, false, value, type); }
+	void Set(int pin, unsigned index, const GUID& value, VarType type) override { Write(LiteralKind::SetTypedAt, pin, index, false, value, type); }
+	void Set(int pin, unsigned index, int value) override { Write(LiteralKind::SetAt, pin, index, false, value); }
+	void Set(int pin, unsigned index, unsigned value) override { Write(LiteralKind::SetAt, pin, index, false, value); }
+	void Set(int pin, unsigned index, double value) override { Write(LiteralKind::SetAt, pin, index, false, value); }
+	void Set(int pin, unsigned index, bool out) override { Write(LiteralKind::SetAt, pin, index, false, out); }
+	void Set(int pin, VarType type, bool out) override { Write(LiteralKind::SetType, pin, None, out, type); }
+	void Set(int pin, VarType type, unsigned index, bool out) override { Write(LiteralKind::SetTypeAt, pin, index, out, type); }
+	void Fill(int pin, long long value) override { Write(LiteralKind::Fill, pin, None, false, value); }
+	void Fill(int pin, float value) override { Write(LiteralKind::Fill, pin, None, false, value); }
+	void Fill(int pin, const Enum& value, VarType type) override { Write(LiteralKind::FillTyped, pin, None, false, value, type); }
+	void Fill(int pin, const GUID& value, VarType type) override { Write(LiteralKind::FillTyped, pin, None, false, value, type); }
+	void Fill(int pin, const std::string& value) override { Write(LiteralKind::Fill, pin, None, false, std::string_view(value)); }
+	void Fill(int pin, const Vec& value) override { Write(LiteralKind::Fill, pin, None, false, value); }
+	void Fill(int pin, const void* ptr, int length, VarType type) override { WriteList(LiteralKind::FillList, pin, None, ptr, length, type); }
+
+	void SetPos(float x, float y) override
+	{
+		Record().x = x;
+		Record().y = y;
+	}
+
+	void SetComment(const std::string& text) override
+	{
+		Record().comment = (std::uint32_t)graph->data.texts.size();
+		graph->data.texts.push_back(text);
+	}
+};
+
+std::size_t MemoryGraph::LiteralKeyHash::operator()(const LiteralKey& key) const
+{
+	std::uint64_t hash = key.node;
+	hash = hash * 0x9E3779B97F4A7C15ull ^ (std::uint32_t)key.pin;
+	hash = hash * 0x9E3779B97F4A7C15ull ^ key.index;
+	hash = hash * 0x9E3779B97F4A7C15ull ^ ((std::uint32_t)key.kind << 1 | key.out);
+	return (std::size_t)(hash ^ hash >> 29);
+}
+
+MemoryGraph::MemoryGraph(std::string name, GraphType type)
+{
+	data.name = std::move(name);
+	data.type = type;
+}
+
+std::uint32_t MemoryGraph::NewNode(NodeId id, std::uint32_t composite)
+{
+	auto slot = (std::uint32_t)data.nodes.size();
+	data.nodes.emplace_back(id, composite, MemoryGraphData::None, 0.f, 0.f, false, true);
+	handles.push_back(nullptr);
+	return slot;
+}
+
+INode& MemoryGraph::Own(std::unique_ptr<INode> node)
+{
+	auto& n = static_cast<MemoryNode&>(*owned.emplace_back(std::move(node)));
+	data.nodes[n.slot].added = true;
+	handles[n.slot] = &n;
+	return n;
+}
+
+void MemoryGraph::CommitLiteral(const LiteralKey& key, std::size_t offset)
+{
+	MemoryGraphData::Literal literal{ key.node, key.pin, key.index, key.kind, key.out, (std::uint32_t)offset, (std::uint32_t)(data.payload.size() - offset) };
+	auto [it, inserted] = literal_index.try_emplace(key, (std::uint32_t)data.literals.size());
+	if (inserted) data.literals.push_back(literal);
+	else data.literals[it->second] = literal;
+}
+
+INode& MemoryGraph::AddNode(NodeId id)
+{
+	return Own(std::make_unique<MemoryNode>(this, NewNode(id, MemoryGraphData::None)));
+}
+
+INode& MemoryGraph::AddNode(std::unique_ptr<INode> node)
+{
+	auto n = dynamic_cast<MemoryNode*>(node.get());
+	if (!n || n->graph != this || data.nodes[n->slot].added) throw std::runtime_error("Node does not belong to this graph");
+	return Own(std::move(node));
+}
+
+void MemoryGraph::AddComment(const std::string& text, float x, float y)
+{
+	data.comments.emplace_back(text, x, y);
+}
+
+std::unique_ptr<INode> MemoryGraph::CreateNode(NodeId id)
+{
+	return std::make_unique<MemoryNode>(this, NewNode(id, MemoryGraphData::None));
+}
+
+std::unique_ptr<INode> MemoryGraph::CreateNode(IGraph& composite)
+{
+	auto graph = dynamic_cast<MemoryGraph*>(&composite);
+	if (!graph || graph->data.type != GraphType::Composite) throw std::runtime_error("Composite node needs an in-memory composite graph");
+	auto& names = data.composites;
+	auto it = std::ranges::find(names, graph->data.name);
+	auto index = (std::uint32_t)(it - names.begin());
+	if (it == names.end()) names.push_back(graph->data.name);
+	return std::make_unique<MemoryNode>(this, NewNode({}, index));
+}
+
+INode* MemoryGraph::Find(unsigned id)
+{
+	return id == 0 || id > handles.size() ? nullptr : handles[id - 1];
+}
+
+void MemoryGraph::SetCompositePin(INode& node, PinType type, uint32_t index, uint32_t composite_pin)
+{
+	auto& n = MemoryNode::Of(node);
+	if (n.graph != this) throw std::runtime_error("Node does not belong to this graph");
+	data.composite_pins.emplace_back(n.slot, type, index, composite_pin);
+}
+
+void MemoryGraph::SetCompositePinName(PinType type, uint32_t index, const std::string& name)
+{
+	data.composite_pin_names.emplace_back(type, index, name);
+}
+
+static constexpr std::array literal_names{ "set", "set-typed", "set-list", "set-list-at", "set-at", "set-typed-at", "set-type", "set-type-at", "fill", "fill-typed", "fill-list" };
+static constexpr std::array pin_names{ "inflow", "outflow", "input", "output" };
+
+MemoryGraphData::Statistics MemoryGraphData::Stats() const
+{
+	auto live = [&](std::uint32_t slot) { return nodes[slot].alive && nodes[slot].added; };
+	Statistics stats{};
+	for (std::uint32_t i = 0; i < nodes.size(); i++) stats.nodes += live(i);
+	for (auto& edge : edges)
+	{
+		if (live(edge.from) && live(edge.to)) (edge.flow ? stats.flow_edges : stats.data_edges)++;
+	}
+	for (auto& literal : literals) stats.literals += live(literal.node);
+	return stats;
+}
+
+std::vector<std::string> MemoryGraphData::Structure() const
+{
+	std::vector<std::uint32_t> rank(nodes.size(), None);
+	std::uint32_t count = 0;
+	for (std::size_t i = 0; i < nodes.size(); i++) if (nodes[i].alive && nodes[i].added) rank[i] = count++;
+	auto live = [&](std::uint32_t slot) { return slot < rank.size() && rank[slot] != None; };
+
+	std::vector<std::string> lines;
+	lines.push_back(std::format("graph {} {}", Quote(name), type == GraphType::Composite ? "composite" : "entity"));
+	for (std::size_t i = 0; i < nodes.size(); i++)
+	{
+		if (!live((std::uint32_t)i)) continue;
+		auto& node = nodes[i];
+		if (node.composite != None) lines.push_back(std::format("node {} composite {}", rank[i], Quote(composites[node.composite])));
+		else lines.push_back(std::format("node {} {}", rank[i], (int)node.id));
+	}
+
+	auto sorted = [&](std::vector<std::string> part)
+		{
+			std::ranges::sort(part);
+			lines.insert(lines.end(), part.begin(), part.end());
+		};
+	std::vector<std::string> part;
+	for (auto& edge : edges)
+	{
+		if (!live(edge.from) || !live(edge.to)) continue;
+		part.push_back(std::format("{} {}:{} -> {}:{}", edge.flow ? "flow" : "data", rank[edge.from], edge.from_pin, rank[edge.to], edge.to_pin));
+	}
+	sorted(std::move(part));
+	part = {};
+	for (auto& literal : literals)
+	{
+		if (!live(literal.node)) continue;
+		PayloadReader reader{ std::span(payload).subspan(literal.offset, literal.length) };
+		std::string value;
+		while (!reader.End()) value += " " + reader.Next();
+		auto index = literal.index == None ? std::string() : std::format("[{}]", literal.index);
+		part.push_back(std::format("{} {}.{}{}{}{}", literal_names[(int)literal.kind], rank[literal.node], literal.out ? "out" : "in", literal.pin, index, value));
+	}
+	sorted(std::move(part));
+	part = {};
+	for (auto& pin : composite_pins)
+	{
+		if (!live(pin.node)) continue;
+		part.push_back(std::format("pin {} {} {} -> {}", rank[pin.node], pin_names[(int)pin.type], pin.index, pin.composite_pin));
+	}
+	for (auto& pin : composite_pin_names) part.push_back(std::format("pin-name {} {} {}", pin_names[(int)pin.type], pin.index, Quote(pin.name)));
+	sorted(std::move(part));
+	return lines;
+}
+
+std::vector<std::string> MemoryGraphData::Layout() const
+{
+	std::vector<std::string> lines;
+	std::uint32_t rank = 0;
+	for (auto& node : nodes)
+	{
+		if (!node.alive || !node.added) continue;
+		lines.push_back(std::format("pos {} {} {}", rank, node.x, node.y));
+		if (node.comment != None) lines.push_back(std::format("note {} {}", rank, Quote(texts[node.comment])));
+		rank++;
+	}
+	for (auto& comment : comments) lines.push_back(std::format("comment {} {} {}", comment.x, comment.y, Quote(comment.text)));
+	return lines;
+}
+
+static void Mix(std::uint64_t& hash, std::string_view text)
+{
+	for (auto c : text) hash = (hash ^ (unsigned char)c) * 1099511628211ull;
+	hash = (hash ^ '\n') * 1099511628211ull;
+}
+
+std::uint64_t MemoryGraphData::Hash() const
+{
+	std::uint64_t hash = 14695981039346656037ull;
+	for (auto& line : Structure()) Mix(hash, line);
+	return hash;
+}
+
+std::optional<std::string> MemoryGraphData::Difference(const MemoryGraphData& other) const
+{
+	auto a = Structure(), b = other.Structure();
+	auto [x, y] = std::ranges::mismatch(a, b);
+	if (x == a.end() && y == b.end()) return std::nullopt;
+	return std::format("{}: {} <> {}", Quote(name), x == a.end() ? "(end)" : *x, y == b.end() ? "(end)" : *y);
+}
+
+std::uint64_t MemoryProject::Hash() const
+{
+	std::uint64_t hash = 14695981039346656037ull;
+	for (auto& name : defined) Mix(hash, name);
+	for (auto& graph : graphs) Mix(hash, std::format("{:016x}", graph.Hash()));
+	return hash;
+}
+
+std::optional<std::string> MemoryProject::Difference(const MemoryProject& other) const
+{
+	if (defined != other.defined) return "Defined graphs differ";
+	if (graphs.size() != other.graphs.size()) return std::format("Graph count differs: {} <> {}", graphs.size(), other.graphs.size());
+	for (std::size_t i = 0; i < graphs.size(); i++)
+	{
+		if (auto difference = graphs[i].Difference(other.graphs[i])) return difference;
+	}
+	return std::nullopt;
+}
+
+void MemoryProject::Add(const IGraph& graph)
+{
+	auto g = dynamic_cast<const MemoryGraph*>(&graph);
+	if (!g) throw std::runtime_error("Only in-memory graphs can be added to an in-memory project");
+	graphs.push_back(g->Data());
+}
+
+void MemoryProject::Define(IGraph& graph)
+{
+	auto g = dynamic_cast<MemoryGraph*>(&graph);
+	if (!g) throw std::runtime_error("Only in-memory graphs can be defined in an in-memory project");
+	if (std::ranges::find(defined, g->Data().name) == defined.end()) defined.push_back(g->Data().name);
+}
+
+void MemoryProject::Save(const std::filesystem::path& path) const
+{
+	std::ofstream file(path, std::ios::binary);
+	if (!file) throw std::runtime_error(std::format("Cannot write '{}'", path.string()));
+	for (auto& name : defined) file << std::format("define {}\n", Quote(name));
+	for (auto& graph : graphs)
+	{
+		for (auto& line : graph.Structure()) file << line << "\n";
+		for (auto& line : graph.Layout()) file << line << "\n";
+	}
+	if (!file.flush()) throw std::runtime_error(std::format("Cannot write '{}'", path.string()));
+}
+
+// one reference per defined graph that is instantiated as a composite somewhere: the graphs doing so and the ids of those nodes
+std::vector<NodeReference> MemoryProject::GetReferences()
+{
+	std::vector<NodeReference> references;
+	for (auto& name : defined)
+	{
+		NodeReference reference{ name };
+		for (auto& graph : graphs)
+		{
+			auto composite = std::ranges::find(graph.composites, name);
+			if (composite == graph.composites.end()) continue;
+			NodeReference::Referenced referenced{ graph.name, graph.type == GraphType::Composite };
+			for (std::size_t i = 0; i < graph.nodes.size(); i++)
+			{
+				auto& node = graph.nodes[i];
+				if (node.alive && node.added && node.composite == (std::uint32_t)(composite - graph.composites.begin())) referenced.ids.push_back((std::uint32_t)i + 1);
+			}
+			if (!referenced.ids.empty()) reference.referenced.push_back(std::move(referenced));
+		}
+		if (!reference.referenced.empty()) references.push_back(std::move(reference));
+	}
+	return references;
+}
+
+std::unique_ptr<IGraph> Editor::Tools::CreateMemoryGraph(const std::string& name, GraphType type)
+{
+	return std::make_unique<MemoryGraph>(name, type);
+}
+
+std::unique_ptr<IProject> Editor::Tools::CreateMemoryProject()
+{
+	return std::make_unique<MemoryProject>();
+}
@@ -0,0 +1,176 @@
+module;
+#include <GINodeGraph.h>
+export module memory_graph;
+
+import std;
+
+using namespace Ugc::NodeGraph;
+
+class MemoryNode;
+
+export namespace Editor::Tools
+{
+	// a graph as plain data: one flat array per kind of record, nodes are addressed by their slot
+	struct MemoryGraphData
+	{
+		static constexpr std::uint32_t None = ~0u;
+
+		enum class LiteralKind : std::uint8_t
+		{
+			Set,
+			SetTyped,
+			SetList,
+			SetListAt,
+			SetAt,
+			SetTypedAt,
+			SetType,
+			SetTypeAt,
+			Fill,
+			FillTyped,
+			FillList
+		};
+
+		struct Node
+		{
+			NodeId id;
+			std::uint32_t composite;
+			std::uint32_t comment;
+			float x, y;
+			bool added;
+			bool alive;
+		};
+
+		struct Edge
+		{
+			std::uint32_t from, to;
+			std::int32_t from_pin, to_pin;
+			bool flow;
+		};
+
+		// the value lives in payload[offset, offset + length), tagged so it can be decoded again
+		struct Literal
+		{
+			std::uint32_t node;
+			std::int32_t pin;
+			std::uint32_t index;
+			LiteralKind kind;
+			bool out;
+			std::uint32_t offset, length;
+		};
+
+		struct CompositePin
+		{
+			std::uint32_t node;
+			PinType type;
+			std::uint32_t index, composite_pin;
+		};
+
+		struct CompositePinName
+		{
+			PinType type;
+			std::uint32_t index;
+			std::string name;
+		};
+
+		struct Comment
+		{
+			std::string text;
+			float x, y;
+		};
+
+		std::string name;
+		GraphType type;
+		std::vector<Node> nodes;
+		std::vector<Edge> edges;
+		std::vector<Literal> literals;
+		std::vector<std::byte> payload;
+		std::vector<std::string> composites;
+		std::vector<std::string> texts;
+		std::vector<CompositePin> composite_pins;
+		std::vector<CompositePinName> composite_pin_names;
+		std::vector<Comment> comments;
+
+		struct Statistics
+		{
+			std::size_t nodes;
+			std::size_t flow_edges;
+			std::size_t data_edges;
+			std::size_t literals;
+		};
+
+		// counts over the added nodes only, like Structure
+		Statistics Stats() const;
+		// the graph as sorted text lines over its added nodes, renumbered densely; positions and comments are layout and left out
+		std::vector<std::string> Structure() const;
+		std::vector<std::string> Layout() const;
+		std::uint64_t Hash() const;
+		// first structural difference between the graphs, if any
+		std::optional<std::string> Difference(const MemoryGraphData& other) const;
+	};
+
+	class MemoryGraph final : public IGraph
+	{
+		friend MemoryNode;
+
+		struct LiteralKey
+		{
+			std::uint32_t node;
+			std::int32_t pin;
+			std::uint32_t index;
+			MemoryGraphData::LiteralKind kind;
+			bool out;
+
+			bool operator==(const LiteralKey&) const = default;
+		};
+
+		struct LiteralKeyHash
+		{
+			std::size_t operator()(const LiteralKey& key) const;
+		};
+
+		MemoryGraphData data;
+		std::unordered_map<LiteralKey, std::uint32_t, LiteralKeyHash> literal_index;
+		std::vector<INode*> handles;
+		std::vector<std::unique_ptr<INode>> owned;
+
+		std::uint32_t NewNode(NodeId id, std::uint32_t composite);
+		INode& Own(std::unique_ptr<INode> node);
+		// turns the bytes appended to the payload since offset into the literal of that key, replacing an earlier one
+		void CommitLiteral(const LiteralKey& key, std::size_t offset);
+
+	public:
+		MemoryGraph(std::string name, GraphType type);
+
+		const MemoryGraphData& Data() const { return data; }
+
+		INode& AddNode(NodeId id) override;
+		INode& AddNode(std::unique_ptr<INode> node) override;
+		void AddComment(const std::string& text, float x, float y) override;
+		std::unique_ptr<INode> CreateNode(NodeId id) override;
+		std::unique_ptr<INode> CreateNode(IGraph& composite) override;
+		INode* Find(unsigned id) override;
+		void SetCompositePin(INode& node, PinType type, uint32_t index, uint32_t composite_pin) override;
+		void SetCompositePinName(PinType type, uint32_t index, const std::string& name) override;
+	};
+
+	// keeps a copy of every graph added to it, so it can be hashed, compared or dumped after the compiler is done
+	class MemoryProject final : public IProject
+	{
+		std::vector<MemoryGraphData> graphs;
+		std::vector<std::string> defined;
+
+	public:
+		const std::vector<MemoryGraphData>& Graphs() const { return graphs; }
+		std::uint64_t Hash() const;
+		std::optional<std::string> Difference(const MemoryProject& other) const;
+
+		void Add(const IGraph& graph) override;
+		void Define(IGraph& graph) override;
+		// writes the structure and layout of every graph as text, stable between runs so dumps can be diffed
+		void Save(const std::filesystem::path& path) const override;
+		std::vector<NodeReference> GetReferences() override;
+	};
+
+	std::unique_ptr<IGraph> CreateMemoryGraph(const std::string& name, GraphType type);
+	std::unique_ptr<IProject> CreateMemoryProject();
+}
@@ -0,0 +1,204 @@
+#include <GINodeGraph.h>
+
+import std;
+import GIScript;
+import compiler;
+import memory_graph;
+import corpus;
+import harness;
+import memory_usage;
+
+using namespace Editor::Tools;
+using namespace Bench;
+
+struct Sample
+{
+	double ms;
+	std::size_t allocations;
+	std::size_t bytes;
+};
+
+struct Phase
+{
+	std::string_view name;
+	std::vector<Sample> samples;
+
+	const Sample& Median()
+	{
+		std::ranges::sort(samples, {}, &Sample::ms);
+		return samples[samples.size() / 2];
+	}
+};
+
+struct Options
+{
+	CorpusOptions corpus;
+	std::size_t repeat = 5;
+	std::filesystem::path output;
+	std::filesystem::path baseline;
+	std::filesystem::path dump;
+};
+
+static constexpr std::string_view usage =
+	"usage: gisc-bench [options]\n"
+	"  --modules <n>      modules in the corpus (default 16)\n"
+	"  --events <n>       event handlers per module (default 6)\n"
+	"  --depth <n>        local function call depth (default 3)\n"
+	"  --expression <n>   operators per expression (default 8)\n"
+	"  --list <n>         elements per list literal (default 8)\n"
+	"  --no-globals       do not generate global functions\n"
+	"  --seed <n>         corpus seed (default 1)\n"
+	"  --repeat <n>       runs to take the median of (default 5)\n"
+	"  --output <file>    write the results as tab-separated values\n"
+	"  --baseline <file>  compare against results written by an earlier run\n"
+	"  --dump <dir>       write the corpus as .gis files and exit\n";
+
+static bool Accept(Options& options, Arguments& args)
+{
+	auto arg = args.Option();
+	if (arg == "--modules") options.corpus.modules = args.Number();
+	else if (arg == "--events") options.corpus.events = args.Number();
+	else if (arg == "--depth") options.corpus.depth = args.Number();
+	else if (arg == "--expression") options.corpus.expression = args.Number();
+	else if (arg == "--list") options.corpus.list = args.Number();
+	else if (arg == "--no-globals") options.corpus.globals = false;
+	else if (arg == "--seed") options.corpus.seed = args.Number();
+	else if (arg == "--repeat") options.repeat = args.Number();
+	else if (arg == "--output") options.output = args.Value();
+	else if (arg == "--baseline") options.baseline = args.Value();
+	else if (arg == "--dump") options.dump = args.Value();
+	else return false;
+	return true;
+}
+
+// allocations are counted by the recorder the compiler reports its phases to, so the bench and gisc agree on them
+template<typename F>
+static Sample Measure(F&& f)
+{
+	Ugc::Memory::Start();
+	auto start = std::chrono::steady_clock::now();
+	f();
+	auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	Ugc::Memory::Stop();
+	auto total = Ugc::Memory::Total();
+	return { ms, total.allocations, total.bytes };
+}
+
+static std::size_t CountNodes(const MemoryProject& project)
+{
+	std::size_t nodes = 0;
+	for (auto& graph : project.Graphs()) nodes += graph.Stats().nodes;
+	return nodes;
+}
+
+// phases as "phase<TAB>name<TAB>ms<TAB>allocations<TAB>bytes"
+static std::map<std::string, double> LoadBaseline(const std::filesystem::path& path)
+{
+	std::map<std::string, double> values;
+	for (auto& fields : ReadRecords(path))
+	{
+		if (fields.size() == 5 && fields[0] == "phase") values[fields[1]] = std::stod(fields[2]);
+		else if (fields.size() == 2 && fields[0] == "nodes_per_second") values["nodes/s"] = std::stod(fields[1]);
+	}
+	return values;
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (auto code = ParseCommandLine("gisc-bench", usage, argc, argv, [&](Arguments& args) { return Accept(options, args); })) return *code;
+	if (options.corpus.modules == 0 || options.repeat == 0)
+	{
+		std::cerr << "gisc-bench: --modules and --repeat must be at least 1\n" << usage;
+		return 2;
+	}
+
+	auto corpus = GenerateCorpus(options.corpus);
+	if (!options.dump.empty())
+	{
+		std::filesystem::create_directories(options.dump);
+		for (auto& [name, code] : corpus) std::ofstream(options.dump / (name + ".gis"), std::ios::binary) << code;
+		std::cout << std::format("gisc-bench: wrote {} modules to {}\n", corpus.size(), options.dump.string());
+		return 0;
+	}
+
+	std::array<Phase, 4> phases{ { { "parse" }, { "add" }, { "compile" }, { "write" } } };
+	std::size_t nodes = 0;
+	std::uint64_t hash = 0;
+	try
+	{
+		for (std::size_t run = 0; run < options.repeat; run++)
+		{
+			// parse alone measures the front end; AddModule parses again and registers the module
+			phases[0].samples.push_back(Measure([&] { for (auto& [name, code] : corpus) Ugc::Script::Parse(code); }));
+			std::unique_ptr<IProject> project;
+			{
+				Compiler compiler(CreateMemoryProject(), CreateMemoryGraph);
+				phases[1].samples.push_back(Measure([&] { for (auto& [name, code] : corpus) compiler.AddModule(name, code); }));
+				phases[2].samples.push_back(Measure([&] { compiler.Compile(); }));
+				phases[3].samples.push_back(Measure([&] { compiler.Write(); }));
+				project = compiler.Release();
+			}
+			auto& result = static_cast<const MemoryProject&>(*project);
+			auto h = result.Hash();
+			if (run && h != hash) throw std::runtime_error("the compiler produced different graphs for the same corpus");
+			hash = h;
+			nodes = CountNodes(result);
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "gisc-bench: " << e.what() << "\n";
+		return 1;
+	}
+
+	double total = 0;
+	std::vector<std::pair<std::string, Sample>> medians;
+	for (auto& phase : phases)
+	{
+		auto& median = medians.emplace_back(std::string(phase.name), phase.Median()).second;
+		if (phase.name != "parse") total += median.ms;
+	}
+	auto nodes_per_second = total > 0 ? nodes / (total / 1000) : 0;
+
+	std::ostringstream results;
+	auto& c = options.corpus;
+	results << std::format("corpus\tmodules={} events={} depth={} expression={} list={} globals={} seed={}\n", c.modules, c.events, c.depth, c.expression, c.list, c.globals, c.seed);
+	results << std::format("repeat\t{}\n", options.repeat);
+	results << std::format("nodes\t{}\n", nodes);
+	results << std::format("graph_hash\t{:016x}\n", hash);
+	for (auto& [name, sample] : medians) results << std::format("phase\t{}\t{:.3f}\t{}\t{}\n", name, sample.ms, sample.allocations, sample.bytes);
+	results << std::format("nodes_per_second\t{:.0f}\n", nodes_per_second);
+
+	if (!options.output.empty())
+	{
+		if (!WriteRecords(options.output, results.str())) std::cerr << std::format("gisc-bench: cannot write '{}'\n", options.output.string());
+	}
+
+	std::cout << std::format("gisc-bench: {} modules, {} nodes, graph hash {:016x}, median of {} runs\n", corpus.size(), nodes, hash, options.repeat);
+	std::map<std::string, double> baseline;
+	if (!options.baseline.empty())
+	{
+		try
+		{
+			baseline = LoadBaseline(options.baseline);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "gisc-bench: " << e.what() << "\n";
+			return 3;
+		}
+	}
+	auto delta = [&](const std::string& key, double value)
+		{
+			auto it = baseline.find(key);
+			if (it == baseline.end() || it->second == 0) return std::string();
+			return std::format("  {:+.1f}%", (value / it->second - 1) * 100);
+		};
+	for (auto& [name, sample] : medians)
+	{
+		std::cout << std::format("  {:<8} {:>10.3f} ms {:>10} allocs {:>12} bytes{}\n", name, sample.ms, sample.allocations, sample.bytes, delta(name, sample.ms));
+	}
+	std::cout << std::format("  {:<8} {:>10.0f}{}\n", "nodes/s", nodes_per_second, delta("nodes/s", nodes_per_second));
+	return 0;
+}
@@ -0,0 +1,137 @@
+export module corpus;
+
+import std;
+
+export namespace Bench
+{
+	struct CorpusOptions
+	{
+		std::size_t modules = 16;
+		std::size_t events = 6;
+		// length of the chain of local functions every module calls through
+		std::size_t depth = 3;
+		// binary operators per generated expression
+		std::size_t expression = 8;
+		std::size_t list = 8;
+		bool globals = true;
+		std::uint64_t seed = 1;
+	};
+
+	struct CorpusFile
+	{
+		std::string name;
+		std::string code;
+	};
+
+	// writes GIScript modules from a seed alone, so the same options give the same corpus on every machine and commit
+	class CorpusGenerator
+	{
+		struct Event
+		{
+			std::string_view name;
+			std::string_view parameters;
+		};
+
+		static constexpr std::array<Event, 6> events{ {
+			{ "OnPresetStatusChanges", "int a, int b, int c" },
+			{ "OnUIControlGroupIsTriggered", "int a, int b" },
+			{ "OnPlayerClassLevelChanges", "int a, int b" },
+			{ "OnCreationReachesPatrolWaypoint", "int a, int b, int c, int d" },
+			{ "OnPathReachesWaypoint", "string a, int b, int c" },
+			{ "OnEquipmentAffixValueChanges", "int a, int b, float c, float d" }
+		} };
+
+		const CorpusOptions& options;
+		std::uint64_t state;
+
+		// splitmix64, the standard distributions are not portable between library implementations
+		std::uint64_t Next()
+		{
+			auto z = state += 0x9E3779B97F4A7C15ull;
+			z = (z ^ z >> 30) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ z >> 27) * 0x94D049BB133111EBull;
+			return z ^ z >> 31;
+		}
+
+		std::size_t Below(std::size_t n) { return (std::size_t)(Next() % n); }
+
+		std::string Expression(std::size_t operators, const std::vector<std::string>& leaves)
+		{
+			if (operators == 0)
+			{
+				if (Below(3) == 0) return std::to_string(1 + Below(99));
+				return leaves[Below(leaves.size())];
+			}
+			// every draw is its own statement, argument evaluation order differs between compilers
+			static constexpr std::array ops{ " + ", " - ", " * " };
+			auto split = Below(operators);
+			auto left = Expression(split, leaves);
+			auto op = ops[Below(ops.size())];
+			auto right = Expression(operators - 1 - split, leaves);
+			return "(" + left + op + right + ")";
+		}
+
+		std::string List()
+		{
+			std::string text = "{";
+			for (std::size_t i = 0; i < options.list; i++) text += std::format("{}{}", i ? ", " : "", Below(1000));
+			return text + "}";
+		}
+
+		void Function(std::string& code, std::size_t module, std::size_t level)
+		{
+			code += std::format("int m{}_f{}(int x)\n{{\n", module, level);
+			auto body = Expression(options.expression / 2, { "x" });
+			auto offset = 1 + Below(9);
+			if (level + 1 < options.depth) code += std::format("\treturn m{}_f{}({}) + {};\n", module, level + 1, body, offset);
+			else code += std::format("\treturn {};\n", body);
+			code += "}\n\n";
+		}
+
+		void Handler(std::string& code, std::size_t module, std::size_t index)
+		{
+			auto& event = events[index % events.size()];
+			code += std::format("event {}({})\n{{\n", event.name, event.parameters);
+			std::vector<std::string> leaves{ "b" };
+			if (event.parameters.starts_with("int a")) leaves.push_back("a");
+			code += std::format("\tint v0 = {};\n", Expression(options.expression, leaves));
+			leaves.push_back("v0");
+			code += std::format("\tint v1 = {};\n", Expression(options.expression, leaves));
+			leaves.push_back("v1");
+			if (options.list) code += std::format("\tlist<int> l = {};\n\tfor (int e : l)\n\t{{\n\t\tv0 += e;\n\t}}\n", List());
+			auto count = 2 + Below(6);
+			code += std::format("\tfor (int i = 0; i < {}; i++)\n\t{{\n\t\tv1 = v1 + {};\n\t}}\n", count, Expression(options.expression / 2, { "i", "v0" }));
+			if (options.depth) code += std::format("\tv0 = m{}_f0({});\n", module, Expression(options.expression / 2, leaves));
+			if (options.globals) code += std::format("\tv1 = g{}(v0, v1);\n", (module + 1) % options.modules);
+			auto threshold = Below(1000);
+			code += std::format("\tif (v0 > {})\n\t{{\n\t\tcounter += v1;\n\t}}\n\telse\n\t{{\n\t\tprint(\"m{}e{}\");\n\t}}\n", threshold, module, index);
+			auto first = Below(10);
+			auto second = 10 + Below(10);
+			code += std::format("\tswitch (v1)\n\t{{\n\tcase {}:\n\t\tcounter = v0;\n\tcase {}:\n\t\tcounter++;\n\tdefault:\n\t\tprint(\"other\");\n\t}}\n", first, second);
+			code += "}\n\n";
+		}
+
+	public:
+		explicit CorpusGenerator(const CorpusOptions& options) : options(options), state(options.seed) {}
+
+		std::vector<CorpusFile> Generate()
+		{
+			std::vector<CorpusFile> files;
+			for (std::size_t m = 0; m < options.modules; m++)
+			{
+				std::string code = "int counter;\n\n";
+				if (options.globals) code += std::format("global int g{}(int x, int y)\n{{\n\treturn {};\n}}\n\n", m, Expression(options.expression, { "x", "y" }));
+				// callees first, so every call names a function that is already declared
+				for (auto d = options.depth; d-- > 0;) Function(code, m, d);
+				for (std::size_t e = 0; e < options.events; e++) Handler(code, m, e);
+				files.emplace_back(std::format("bench_{:04}", m), std::move(code));
+			}
+			return files;
+		}
+	};
+
+	std::vector<CorpusFile> GenerateCorpus(const CorpusOptions& options)
+	{
+		return CorpusGenerator(options).Generate();
+	}
+}
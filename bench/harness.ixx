@@ -0,0 +1,101 @@
+module;
+#include <GINodeGraph.h>
+export module harness;
+
+import std;
+import compiler;
+import memory_graph;
+
+export namespace Bench
+{
+	// every snippet is the body of the same handler, so two snippets only differ in the graph by what they differ in
+	std::unique_ptr<Ugc::NodeGraph::IProject> CompileSnippet(std::string_view module, std::string_view preface, std::string_view body)
+	{
+		auto code = std::format("{}event OnCreationReachesPatrolWaypoint(int a, int b, int c, int d)\n{{\n\t{}\n}}\n", preface, body);
+		Editor::Tools::Compiler compiler(Editor::Tools::CreateMemoryProject(), Editor::Tools::CreateMemoryGraph);
+		compiler.AddModule(std::string(module), code);
+		compiler.Compile();
+		compiler.Write();
+		return compiler.Release();
+	}
+
+	// results files: one "key<TAB>value..." record per line
+	std::vector<std::vector<std::string>> ReadRecords(const std::filesystem::path& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file) throw std::runtime_error(std::format("cannot read '{}'", path.string()));
+		std::vector<std::vector<std::string>> records;
+		for (std::string line; std::getline(file, line);)
+		{
+			auto& fields = records.emplace_back();
+			for (auto f : std::views::split(line, '\t')) fields.emplace_back(f.begin(), f.end());
+		}
+		return records;
+	}
+
+	bool WriteRecords(const std::filesystem::path& path, const std::string& records)
+	{
+		std::ofstream file(path, std::ios::binary);
+		return static_cast<bool>(file << records);
+	}
+
+	// "--option value" command lines, a missing or malformed value throws std::invalid_argument
+	class Arguments
+	{
+		int argc;
+		char** argv;
+		int index = 0;
+		std::string_view option;
+	public:
+		Arguments(int argc, char** argv) : argc(argc), argv(argv) {}
+
+		bool Next()
+		{
+			if (++index >= argc) return false;
+			option = argv[index];
+			return true;
+		}
+
+		std::string_view Option() const { return option; }
+
+		std::string_view Value()
+		{
+			if (index + 1 >= argc) throw std::invalid_argument(std::format("option '{}' needs a value", option));
+			return argv[++index];
+		}
+
+		std::size_t Number()
+		{
+			auto text = Value();
+			std::size_t n;
+			auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), n);
+			if (ec != std::errc() || end != text.data() + text.size()) throw std::invalid_argument(std::format("option '{}' needs a number", option));
+			return n;
+		}
+	};
+
+	// hands every option to accept, which returns false for one it does not know; the result is the exit code when the tool should stop
+	template<typename F>
+	std::optional<int> ParseCommandLine(std::string_view tool, std::string_view usage, int argc, char** argv, F&& accept)
+	{
+		Arguments args(argc, argv);
+		try
+		{
+			while (args.Next())
+			{
+				if (args.Option() == "-h" || args.Option() == "--help")
+				{
+					std::cout << usage;
+					return 0;
+				}
+				if (!accept(args)) throw std::invalid_argument(std::format("unknown option '{}'", args.Option()));
+			}
+		}
+		catch (const std::invalid_argument& e)
+		{
+			std::cerr << std::format("{}: {}\n", tool, e.what()) << usage;
+			return 2;
+		}
+		return std::nullopt;
+	}
+}
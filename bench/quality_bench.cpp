@@ -0,0 +1,176 @@
+#include <GINodeGraph.h>
+
+import std;
+import compiler;
+import memory_graph;
+import harness;
+
+using namespace Editor::Tools;
+using namespace Ugc::NodeGraph;
+using namespace Bench;
+
+struct Construct
+{
+	std::string_view name;
+	// declarations placed before the handler
+	std::string_view preface;
+	std::string_view body;
+};
+
+// every body runs in the same handler, so the "empty" row is the cost the other rows share
+static constexpr std::array<Construct, 32> constructs{ {
+	{ "empty", "", "" },
+	{ "arithmetic", "", "int x = a * b + c;" },
+	{ "compound", "", "int x = a; x += b; x *= c;" },
+	{ "increment", "", "int x = a; x++; ++x;" },
+	{ "ternary", "", "int x = a > b ? a : b;" },
+	{ "ternary-clamp", "", "int x = a > c ? c : (a < b ? b : a);" },
+	{ "ternary-abs", "", "int x = a < 0 ? -a : a;" },
+	{ "ternary-sign", "", "int x = a > 0 ? 1 : (a < 0 ? -1 : 0);" },
+	{ "ternary-guarded-index", "", "list<int> l = { a, b }; int x = c < GetListLength(l) ? l[c] : 0;" },
+	{ "ternary-guarded-divide", "", "int x = a != 0 ? b / a : 0;" },
+	{ "ternary-guarded-member", "", "entity e = this; int x = e != null ? e.hp as int : 0;" },
+	{ "logical", "", "if (a > b && b > c || d == 0) print(\"x\");" },
+	{ "if", "", "if (a > b) print(\"a\"); else print(\"b\");" },
+	{ "for", "", "for (int i = 0; i < a; i++) print(\"i\");" },
+	{ "for-break", "", "for (int i = 0; i < a; i++) { if (i > b) break; print(\"i\"); }" },
+	{ "while", "", "int i = 0; while (i < a) i++;" },
+	{ "foreach", "", "list<int> l = { a, b }; for (int e : l) print(\"e\");" },
+	{ "switch-int", "", "switch (a) { case 1: print(\"one\"); case 2: print(\"two\"); default: print(\"other\"); }" },
+	{ "switch-string", "", "string s = \"x\"; switch (s) { case \"x\": print(\"x\"); case \"y\": print(\"y\"); }" },
+	{ "list-literal", "", "list<int> l = { a, b, c, 4 };" },
+	{ "list-constant", "", "list<int> l = { 1, 2, 3, 4 };" },
+	{ "list-index", "", "list<int> l = { a, b }; int x = l[1];" },
+	{ "vec-member", "", "vec v = Create3DVector(1.0, 2.0, 3.0); float f = v.y;" },
+	{ "custom-get", "", "int x = this.hp as int;" },
+	{ "custom-set", "", "this.hp = a;" },
+	{ "custom-compound", "", "this.hp += a;" },
+	{ "graph-variable", "int counter;\n", "counter += a;" },
+	{ "builtin-call", "", "float r = GetRandomFloatingPointNumber(0.5, 1.5);" },
+	{ "local-call", "int twice(int x)\n{\n\treturn x * 2;\n}\n", "int y = twice(a);" },
+	{ "inline-call", "inline int twice(int x)\n{\n\treturn x * 2;\n}\n", "int y = twice(a);" },
+	{ "global-call", "global int twice(int x)\n{\n\treturn x * 2;\n}\n", "int y = twice(a);" },
+	{ "return", "int pick(int x)\n{\n\tint y = 0;\n\tif (x > 0) y = x;\n\treturn y;\n}\n", "int y = pick(a);" }
+} };
+
+struct Counts
+{
+	std::size_t nodes = 0;
+	std::size_t flow_edges = 0;
+	std::size_t data_edges = 0;
+	std::size_t locals = 0;
+};
+
+static bool IsLocalVariable(NodeId id)
+{
+	using enum NodeId;
+	static constexpr std::array ids{ GetLocalVariableBool, GetLocalVariableInt, GetLocalVariableStr, GetLocalVariableEntity, GetLocalVariableGUID, GetLocalVariableFloat, GetLocalVariableVec,
+		GetLocalVariableListInt, GetLocalVariableListStr, GetLocalVariableListEntity, GetLocalVariableListGUID, GetLocalVariableListFloat, GetLocalVariableListVec, GetLocalVariableListBool,
+		GetLocalVariableConfig, GetLocalVariablePrefab, GetLocalVariableListConfig, GetLocalVariableListPrefab, GetLocalVariableFaction, GetLocalVariableListFaction };
+	return std::ranges::contains(ids, id);
+}
+
+// counts every graph the snippet produced, composites of global functions included
+static Counts Count(const MemoryProject& project)
+{
+	Counts counts;
+	for (auto& graph : project.Graphs())
+	{
+		auto stats = graph.Stats();
+		counts.nodes += stats.nodes;
+		counts.flow_edges += stats.flow_edges;
+		counts.data_edges += stats.data_edges;
+		for (auto& node : graph.nodes)
+		{
+			if (node.alive && node.added && node.composite == MemoryGraphData::None && IsLocalVariable(node.id)) counts.locals++;
+		}
+	}
+	return counts;
+}
+
+// constructs as "construct<TAB>name<TAB>nodes<TAB>flow edges<TAB>data edges<TAB>locals"
+static std::map<std::string, Counts> LoadBaseline(const std::filesystem::path& path)
+{
+	std::map<std::string, Counts> values;
+	for (auto& fields : ReadRecords(path))
+	{
+		if (fields.size() == 6 && fields[0] == "construct") values[fields[1]] = { std::stoull(fields[2]), std::stoull(fields[3]), std::stoull(fields[4]), std::stoull(fields[5]) };
+	}
+	return values;
+}
+
+static constexpr std::string_view usage =
+	"usage: gisc-quality [options]\n"
+	"  --output <file>    write the counts as tab-separated values\n"
+	"  --baseline <file>  compare against counts written by an earlier run\n"
+	"  --graphs <dir>     save the graphs of every construct as text\n"
+	"  --filter <text>    only constructs whose name contains text\n";
+
+int main(int argc, char** argv)
+{
+	std::filesystem::path output, baseline_path, graphs;
+	std::string filter;
+	auto accept = [&](Arguments& args)
+		{
+			auto arg = args.Option();
+			if (arg == "--output") output = args.Value();
+			else if (arg == "--baseline") baseline_path = args.Value();
+			else if (arg == "--graphs") graphs = args.Value();
+			else if (arg == "--filter") filter = args.Value();
+			else return false;
+			return true;
+		};
+	if (auto code = ParseCommandLine("gisc-quality", usage, argc, argv, accept)) return *code;
+
+	std::map<std::string, Counts> baseline;
+	try
+	{
+		if (!baseline_path.empty()) baseline = LoadBaseline(baseline_path);
+		if (!graphs.empty()) std::filesystem::create_directories(graphs);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "gisc-quality: " << e.what() << "\n";
+		return 3;
+	}
+
+	auto delta = [&](std::string_view name, std::size_t Counts::* field, std::size_t value)
+		{
+			auto it = baseline.find(std::string(name));
+			if (it == baseline.end() || it->second.*field == value) return std::string();
+			return std::format("({:+})", (long long)value - (long long)(it->second.*field));
+		};
+
+	std::ostringstream results;
+	bool failed = false;
+	std::cout << std::format("{:<16} {:>12} {:>12} {:>12} {:>12}\n", "construct", "nodes", "flow edges", "data edges", "locals");
+	for (auto& construct : constructs)
+	{
+		if (!construct.name.contains(filter)) continue;
+		try
+		{
+			auto project = CompileSnippet(construct.name, construct.preface, construct.body);
+			auto& result = static_cast<const MemoryProject&>(*project);
+			if (!graphs.empty()) result.Save(graphs / std::format("{}.txt", construct.name));
+			auto counts = Count(result);
+			auto cell = [&](std::size_t Counts::* field) { return std::format("{}{}", counts.*field, delta(construct.name, field, counts.*field)); };
+			std::cout << std::format("{:<16} {:>12} {:>12} {:>12} {:>12}\n", construct.name, cell(&Counts::nodes), cell(&Counts::flow_edges), cell(&Counts::data_edges), cell(&Counts::locals));
+			results << std::format("construct\t{}\t{}\t{}\t{}\t{}\n", construct.name, counts.nodes, counts.flow_edges, counts.data_edges, counts.locals);
+		}
+		catch (const std::exception& e)
+		{
+			std::cout << std::format("{:<16} error: {}\n", construct.name, e.what());
+			failed = true;
+		}
+	}
+
+	if (!output.empty())
+	{
+		if (!WriteRecords(output, results.str()))
+		{
+			std::cerr << std::format("gisc-quality: cannot write '{}'\n", output.string());
+			return 3;
+		}
+	}
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,6 @@
+#include <GINodeGraph.h>
+
+// GINodeGraph defines these along with the rest of the library; builds without it still need them for its interfaces
+Ugc::NodeGraph::INode::~INode() {}
+Ugc::NodeGraph::IGraph::~IGraph() {}
+Ugc::NodeGraph::IProject::~IProject() {}
@@ -0,0 +1,273 @@
+#include <GINodeGraph.h>
+
+import std;
+import compiler;
+import memory_graph;
+import trace;
+import memory_usage;
+
+using namespace Ugc::NodeGraph;
+using namespace Editor::Tools;
+
+enum ExitCode
+{
+	Success = 0,
+	CompileError = 1,
+	UsageError = 2,
+	IoError = 3
+};
+
+struct Backend
+{
+	// an empty path asks for a new, empty project
+	std::function<std::unique_ptr<IProject>(const std::filesystem::path&)> load;
+	GraphFactory create_graph;
+};
+
+static std::map<std::string, Backend> Backends()
+{
+	std::map<std::string, Backend> backends;
+	backends["memory"] = {
+		[](const std::filesystem::path& path)
+		{
+			if (!path.empty()) throw std::runtime_error("The memory backend always starts from an empty project");
+			return CreateMemoryProject();
+		},
+		CreateMemoryGraph
+	};
+#ifdef GISC_WITH_GINODEGRAPH
+	backends["ginodegraph"] = {
+		[](const std::filesystem::path& path)
+		{
+			if (path.empty()) throw std::runtime_error("The ginodegraph backend needs a project file");
+			return LoadProject(path);
+		},
+		CreateGraph
+	};
+#endif
+	return backends;
+}
+
+struct Options
+{
+	std::filesystem::path scripts;
+	std::filesystem::path project;
+	std::filesystem::path output;
+	std::filesystem::path cache;
+	std::filesystem::path trace;
+	std::filesystem::path memory;
+	std::string backend;
+	bool write = true;
+	bool quiet = false;
+};
+
+static void Usage(std::ostream& out)
+{
+	out << "usage: gisc [options] <script-dir>\n"
+		"  -p, --project <file>   project to compile into\n"
+		"  -o, --output <file>    where to save the project (default: the project file)\n"
+		"  -b, --backend <name>   graph backend:";
+	for (auto& [name, backend] : Backends()) out << " " << name;
+	out << "\n"
+		"  -c, --cache <dir>      reuse lowered modules from earlier builds, without outlining\n"
+		"      --no-write         compile only, do not save the project\n"
+		"      --trace <file>     record the phases as a Chrome trace (chrome://tracing, Perfetto)\n"
+		"      --memory <file>    count allocations and peak memory per phase and module, written as tab-separated values\n"
+		"  -q, --quiet            do not print the summary\n"
+		"exit codes: 0 success, 1 compile error, 2 usage error, 3 i/o error\n";
+}
+
+static std::optional<Options> ParseArguments(int argc, char** argv)
+{
+	Options options;
+	auto backends = Backends();
+	if (!backends.empty()) options.backend = backends.begin()->first;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string_view arg = argv[i];
+		auto value = [&]() -> const char*
+			{
+				if (i + 1 >= argc) throw std::invalid_argument(std::format("option '{}' needs a value", arg));
+				return argv[++i];
+			};
+		if (arg == "-p" || arg == "--project") options.project = value();
+		else if (arg == "-o" || arg == "--output") options.output = value();
+		else if (arg == "-b" || arg == "--backend") options.backend = value();
+		else if (arg == "-c" || arg == "--cache") options.cache = value();
+		else if (arg == "--trace") options.trace = value();
+		else if (arg == "--memory") options.memory = value();
+		else if (arg == "--no-write") options.write = false;
+		else if (arg == "-q" || arg == "--quiet") options.quiet = true;
+		else if (arg == "-h" || arg == "--help") return std::nullopt;
+		else if (arg.starts_with("-")) throw std::invalid_argument(std::format("unknown option '{}'", arg));
+		else if (options.scripts.empty()) options.scripts = arg;
+		else throw std::invalid_argument("only one script directory can be given");
+	}
+	if (options.scripts.empty()) throw std::invalid_argument("no script directory given");
+	if (!backends.contains(options.backend)) throw std::invalid_argument(options.backend.empty() ? "gisc was built without a graph backend" : std::format("unknown backend '{}'", options.backend));
+	if (options.output.empty()) options.output = options.project;
+	if (options.write && options.output.empty()) throw std::invalid_argument("nowhere to save the project, give --project, --output or --no-write");
+	return options;
+}
+
+static std::string Megabytes(std::int64_t bytes)
+{
+	return std::format("{:.1f} MiB", bytes / (1024.0 * 1024.0));
+}
+
+// the report summed over modules, so every phase is one line
+static void PrintMemory()
+{
+	std::vector<Ugc::Memory::Usage> phases;
+	for (auto& u : Ugc::Memory::Report())
+	{
+		auto it = std::ranges::find(phases, u.phase, &Ugc::Memory::Usage::phase);
+		if (it == phases.end())
+		{
+			phases.push_back(u);
+			phases.back().module.clear();
+			continue;
+		}
+		it->allocations += u.allocations;
+		it->bytes += u.bytes;
+		it->peak = std::max(it->peak, u.peak);
+	}
+	phases.push_back(Ugc::Memory::Total());
+	std::cout << std::format("  {:<10} {:>12} {:>14} {:>14}\n", "memory", "allocations", "allocated", "peak");
+	for (auto& u : phases) std::cout << std::format("  {:<10} {:>12} {:>14} {:>14}\n", u.phase, u.allocations, Megabytes(u.bytes), Megabytes(u.peak));
+}
+
+static std::string ReadFile(const std::filesystem::path& path)
+{
+	std::ifstream in(path, std::ios::binary);
+	if (!in) throw std::runtime_error(std::format("cannot read '{}'", path.string()));
+	return { std::istreambuf_iterator<char>(in), {} };
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	try
+	{
+		auto parsed = ParseArguments(argc, argv);
+		if (!parsed)
+		{
+			Usage(std::cout);
+			return Success;
+		}
+		options = std::move(*parsed);
+	}
+	catch (const std::invalid_argument& e)
+	{
+		std::cerr << "gisc: " << e.what() << "\n";
+		Usage(std::cerr);
+		return UsageError;
+	}
+
+	using Clock = std::chrono::steady_clock;
+	std::vector<std::pair<std::string_view, Clock::duration>> timings;
+	auto measure = [&](std::string_view phase, auto&& f)
+		{
+			auto start = Clock::now();
+			f();
+			timings.emplace_back(phase, Clock::now() - start);
+		};
+
+	std::vector<std::filesystem::path> files;
+	std::unique_ptr<Compiler> compiler;
+	try
+	{
+		if (!std::filesystem::is_directory(options.scripts)) throw std::runtime_error(std::format("script directory '{}' does not exist", options.scripts.string()));
+		if (!options.project.empty() && !std::filesystem::is_regular_file(options.project)) throw std::runtime_error(std::format("project file '{}' does not exist", options.project.string()));
+		for (auto& entry : std::filesystem::directory_iterator(options.scripts))
+		{
+			if (entry.is_regular_file() && entry.path().extension() == ".gis") files.push_back(entry.path());
+		}
+		// directory order is unspecified, sorting keeps the output stable between runs
+		std::ranges::sort(files);
+		auto backends = Backends();
+		auto& backend = backends.at(options.backend);
+		if (!options.trace.empty()) Ugc::Trace::Start();
+		if (!options.memory.empty()) Ugc::Memory::Start();
+		measure("load", [&]
+			{
+				Ugc::Memory::Scope memory("Load");
+				compiler = std::make_unique<Compiler>(backend.load(options.project), backend.create_graph);
+			});
+		if (!options.cache.empty()) compiler->EnableCache(options.cache);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "gisc: " << e.what() << "\n";
+		return IoError;
+	}
+
+	try
+	{
+		measure("add", [&]
+			{
+				for (auto& file : files)
+				{
+					auto stem = file.stem().u8string();
+					std::string name(stem.begin(), stem.end());
+					try
+					{
+						compiler->AddModule(name, ReadFile(file));
+					}
+					catch (const std::exception& e)
+					{
+						throw std::runtime_error(std::format("{}: {}", file.filename().string(), e.what()));
+					}
+				}
+			});
+		measure("compile", [&] { compiler->Compile(); });
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "gisc: " << e.what() << "\n";
+		return CompileError;
+	}
+
+	if (options.write)
+	{
+		try
+		{
+			measure("write", [&]
+				{
+					compiler->Write();
+					Ugc::Trace::Span span("Save", options.output.string());
+					Ugc::Memory::Scope memory("Save");
+					compiler->Release()->Save(options.output);
+				});
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "gisc: " << e.what() << "\n";
+			return IoError;
+		}
+	}
+
+	if (!options.memory.empty()) Ugc::Memory::Stop();
+	try
+	{
+		if (!options.trace.empty())
+		{
+			Ugc::Trace::Stop();
+			Ugc::Trace::Save(options.trace);
+		}
+		if (!options.memory.empty()) Ugc::Memory::Save(options.memory);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "gisc: " << e.what() << "\n";
+		return IoError;
+	}
+
+	if (!options.quiet)
+	{
+		std::cout << std::format("gisc: {} modules, {} from cache, {} nodes simplified, {} sequences outlined\n", files.size(), compiler->Cached(), compiler->Simplified(), compiler->Outlined());
+		for (auto& [phase, duration] : timings) std::cout << std::format("  {:<8} {:>10.3f} ms\n", phase, std::chrono::duration<double, std::milli>(duration).count());
+		if (!options.memory.empty()) PrintMemory();
+	}
+	return Success;
+}
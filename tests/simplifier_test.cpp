@@ -0,0 +1,93 @@
+#include <GINodeGraph.h>
+
+import std;
+import compiler;
+import memory_graph;
+import harness;
+
+using namespace Editor::Tools;
+using namespace Ugc::NodeGraph;
+
+struct Case
+{
+	// the simplifier rule the snippet exercises, as it is named there
+	std::string_view rule;
+	std::string_view expression;
+	// what the expression must lower to, written without anything the simplifier rewrites
+	std::string_view expected;
+};
+
+static constexpr std::array<Case, 27> cases{ {
+	{ "x + 0", "int x = a + 0;", "int x = a;" },
+	{ "0 + x", "float g = 0.0 + f;", "float g = f;" },
+	{ "x - 0", "int x = a - 0;", "int x = a;" },
+	{ "x - x", "int x = a - a;", "int x = 0;" },
+	{ "x * 1", "vec w = v * 1.0;", "vec w = v;" },
+	{ "1 * x", "int x = 1 * a;", "int x = a;" },
+	{ "x / 1", "float g = f / 1.0;", "float g = f;" },
+	{ "x / c", "float g = f / 4.0;", "float g = f * 0.25;" },
+	{ "x << 0", "int x = a << 0;", "int x = a;" },
+	{ "x >> 0", "int x = a >> 0;", "int x = a;" },
+	{ "x | 0", "int x = a | 0;", "int x = a;" },
+	{ "0 | x", "int x = 0 | a;", "int x = a;" },
+	{ "x ^ 0", "int x = a ^ 0;", "int x = a;" },
+	{ "0 ^ x", "int x = 0 ^ a;", "int x = a;" },
+	{ "b == true", "bool q = p == true;", "bool q = p;" },
+	{ "true == b", "bool q = true == p;", "bool q = p;" },
+	{ "b != false", "bool q = p != false;", "bool q = p;" },
+	{ "false != b", "bool q = false != p;", "bool q = p;" },
+	{ "b && true", "bool q = p && true;", "bool q = p;" },
+	{ "true && b", "bool q = true && p;", "bool q = p;" },
+	{ "b || false", "bool q = p || false;", "bool q = p;" },
+	{ "false || b", "bool q = false || p;", "bool q = p;" },
+	{ "b ^ false", "bool q = p ^ false;", "bool q = p;" },
+	{ "false ^ b", "bool q = false ^ p;", "bool q = p;" },
+	{ "!!b", "bool q = !!p;", "bool q = p;" },
+	{ "--x", "int x = - -a;", "int x = a;" },
+	{ "~~x", "int x = ~~a;", "int x = a;" }
+} };
+
+// every snippet shares the locals, so only the expression under test differs between the two graphs
+static std::unique_ptr<IProject> CompileStatement(std::string_view statement)
+{
+	auto body = std::format("float f = GetRandomFloatingPointNumber(0.5, 1.5);\n"
+		"\tbool p = a > b;\n"
+		"\tvec v = Create3DVector(f, f, f);\n"
+		"\t{}", statement);
+	return Bench::CompileSnippet("simplifier", "", body);
+}
+
+// an empty result means the expression left exactly the graph of the expected snippet, which it only can when the rule fired
+static std::string Check(const Case& c)
+{
+	auto actual = CompileStatement(c.expression);
+	auto expected = CompileStatement(c.expected);
+	auto difference = static_cast<const MemoryProject&>(*actual).Difference(static_cast<const MemoryProject&>(*expected));
+	return difference.value_or(std::string());
+}
+
+int main(int argc, char** argv)
+{
+	std::string_view filter = argc > 1 ? argv[1] : "";
+	std::size_t failed = 0;
+	for (auto& c : cases)
+	{
+		if (!c.rule.contains(filter)) continue;
+		std::string error;
+		try
+		{
+			error = Check(c);
+		}
+		catch (const std::exception& e)
+		{
+			error = e.what();
+		}
+		if (error.empty()) std::cout << std::format("ok    {}\n", c.rule);
+		else
+		{
+			std::cout << std::format("FAIL  {}: {}\n", c.rule, error);
+			failed++;
+		}
+	}
+	return failed ? 1 : 0;
+}